@@ -350,6 +350,22 @@ $1([r2], [b4_r2],
 ])
 
 
+# b4_expected_tables_map(MACRO)
+# -----------------------------
+# With parse.expected-tables, map MACRO on the tables of the expected
+# tokens, if they are needed, i.e., without LAC and with error messages
+# that list the expected tokens.  Check parse.expected-tables last, so
+# that it is reported as unused otherwise.
+m4_define([b4_expected_tables_map],
+[b4_lac_if([], [b4_parse_error_bmatch([simple], [], [b4_expected_tables_if(
+[$1([expected_index], [b4_expected_index],
+    [[YYEXPECTED_INDEX[STATE-NUM] -- Index in YYEXPECTED_TOKENS of the
+tokens expected in state STATE-NUM, i.e., those with an explicit action.]])
+
+$1([expected_tokens], [b4_expected_tokens])
+])])])])
+
+
 # b4_parser_tables_declare
 # b4_parser_tables_define
 # ------------------------
@@ -1026,6 +1042,18 @@ m4_define([b4_percent_define_check_kind],
 ])
 
 
+# b4_percent_define_check_integer(VARIABLE)
+# -----------------------------------------
+# Complain if VARIABLE is defined, but not to a non-negative integer.
+m4_define([b4_percent_define_check_integer],
+[_b4_percent_define_ifdef([$1],
+  [m4_bmatch(m4_indir([b4_percent_define(]$1[)]), [^[0123456789]+$], [],
+    [b4_complain_at(b4_percent_define_get_loc([$1]),
+                    [[%%define variable '%s' requires non-negative integer values]],
+                    [$1])])])dnl
+])
+
+
 # b4_percent_define_check_values(VALUES)
 # --------------------------------------
 # Mimic muscle_percent_define_check_values in ../src/muscle-tab.h exactly
@@ -1106,13 +1134,19 @@ m4_define([b4_percent_code_ifdef],
 
 
 # b4_parse_assert_if([IF-ASSERTIONS-ARE-USED], [IF-NOT])
+# b4_parse_stats_if([IF-PARSE-STATISTICS-ARE-COLLECTED], [IF-NOT])
 # b4_parse_trace_if([IF-DEBUG-TRACES-ARE-ENABLED], [IF-NOT])
 # b4_token_ctor_if([IF-YYLEX-RETURNS-A-TOKEN], [IF-NOT])
+# b4_location_compact_if([IF-LOCATIONS-ARE-OFFSETS], [IF-NOT])
+# b4_expected_tables_if([IF-EXPECTED-TOKENS-ARE-TABULATED], [IF-NOT])
 # ----------------------------------------------------------
 b4_percent_define_if_define([api.token.raw])
 b4_percent_define_if_define([token_ctor], [api.token.constructor])
 b4_percent_define_if_define([locations])     # Whether locations are tracked.
+b4_percent_define_if_define([location_compact], [api.location.compact])
 b4_percent_define_if_define([parse.assert])
+b4_percent_define_if_define([parse.stats])
+b4_percent_define_if_define([expected_tables], [parse.expected-tables])
 b4_percent_define_if_define([parse.trace])
 b4_percent_define_if_define([posix])
 
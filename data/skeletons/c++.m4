@@ -637,6 +637,12 @@ m4_define([b4_public_types_define],
 m4_define([b4_token_constructor_define], [])
 
 
+# b4_location_line_column_define
+# ------------------------------
+# C++ parsers use line_index, see location.cc.
+m4_define([b4_location_line_column_define], [])
+
+
 # b4_yytranslate_define(cc|hh)
 # ----------------------------
 # Define yytranslate_.  Sometimes used in the header file ($1=hh),
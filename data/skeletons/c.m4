@@ -962,16 +962,26 @@ m4_define([b4_location_type_define],
 [[#if ! defined ]b4_api_PREFIX[LTYPE && ! defined ]b4_api_PREFIX[LTYPE_IS_DECLARED
 typedef struct ]b4_api_PREFIX[LTYPE ]b4_api_PREFIX[LTYPE;
 struct ]b4_api_PREFIX[LTYPE
-{
+{]b4_location_compact_if([[
+  /* Byte offset of the first character.  */
+  int begin;
+  /* Byte offset after the last character.  */
+  int end;]], [[
   int first_line;
   int first_column;
   int last_line;
-  int last_column;
+  int last_column;]])[
 };
 # define ]b4_api_PREFIX[LTYPE_IS_DECLARED 1
 # define ]b4_api_PREFIX[LTYPE_IS_TRIVIAL 1
 #endif
-]])])
+]b4_location_compact_if([[
+/* Set *LINE and *COLUMN to the line and column numbers of the byte
+   OFFSET, given LINES, the increasing byte offsets of the beginning of
+   the NLINES lines after the first one.  */
+void ]b4_prefix[location_line_column (int const *lines, int nlines, int offset,
+                           int *line, int *column);
+]])])])
 
 
 # b4_declare_yylstype
@@ -1026,7 +1036,16 @@ m4_define([b4_yylloc_default_define],
    the previous symbol: RHS[0] (always defined).  */
 
 #ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \]b4_location_compact_if([[
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).begin = YYRHSLOC (Rhs, 1).begin;                    \
+          (Current).end   = YYRHSLOC (Rhs, N).end;                      \
+        }                                                               \
+      else                                                              \
+        (Current).begin = (Current).end = YYRHSLOC (Rhs, 0).end;        \
+    while (0)]], [[
     do                                                                  \
       if (N)                                                            \
         {                                                               \
@@ -1042,7 +1061,7 @@ m4_define([b4_yylloc_default_define],
           (Current).first_column = (Current).last_column =              \
             YYRHSLOC (Rhs, 0).last_column;                              \
         }                                                               \
-    while (0)
+    while (0)]])[
 #endif
 ]])
 
@@ -1070,7 +1089,12 @@ m4_define([b4_yylocation_print_define],
 YY_ATTRIBUTE_UNUSED
 static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
-{
+{]b4_location_compact_if([[
+  int res = YYFPRINTF (yyo, "%d", yylocp->begin);
+  if (yylocp->begin + 1 < yylocp->end)
+    res += YYFPRINTF (yyo, "-%d", yylocp->end - 1);
+  return res;
+}]], [[
   int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
@@ -1091,7 +1115,7 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
-}
+}]])[
 
 #   define YYLOCATION_PRINT  yy_location_print_
 
@@ -1110,16 +1134,46 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 # endif /* !defined YYLOCATION_PRINT */]])
 ])
 
+# b4_location_line_column_define
+# ------------------------------
+# With compact locations and the default location type, define
+# yylocation_line_column.  Redefined in c++.m4.
+m4_define([b4_location_line_column_define],
+[b4_bison_locations_if([b4_location_compact_if([[
+void
+]b4_prefix[location_line_column (int const *yylines, int yynlines, int yyoffset,
+                           int *yyline, int *yycolumn)
+{
+  /* Number of lines after the first one that start at or before
+     YYOFFSET.  */
+  int yylo = 0;
+  int yyhi = yynlines;
+  while (yylo < yyhi)
+    {
+      int yymid = yylo + (yyhi - yylo) / 2;
+      if (yylines[yymid] <= yyoffset)
+        yylo = yymid + 1;
+      else
+        yyhi = yymid;
+    }
+  *yyline = ]b4_location_initial_line[ + yylo;
+  *yycolumn = ]b4_location_initial_column[ + yyoffset;
+  if (yylo)
+    *yycolumn -= yylines[yylo - 1];
+}
+]])])])
+
 # b4_yyloc_default
 # ----------------
 # Expand to a possible default value for yylloc.
 m4_define([b4_yyloc_default],
 [[
 # if defined ]b4_api_PREFIX[LTYPE_IS_TRIVIAL && ]b4_api_PREFIX[LTYPE_IS_TRIVIAL
-  = { ]m4_join([, ],
+  = { ]b4_location_compact_if([[0, 0]],
+                             [m4_join([, ],
                m4_defn([b4_location_initial_line]),
                m4_defn([b4_location_initial_column]),
                m4_defn([b4_location_initial_line]),
-               m4_defn([b4_location_initial_column]))[ }
+               m4_defn([b4_location_initial_column]))])[ }
 # endif
 ]])
@@ -416,6 +416,7 @@ dnl We probably ought to introduce a type for confl.
 
 ]b4_locations_if([[
 ]b4_yylloc_default_define[
+]b4_location_line_column_define[
 # define YYRHSLOC(Rhs, K) ((Rhs)[K].yystate.yyloc)
 ]])[
 
@@ -288,7 +288,8 @@ m4_define([b4_shared_declarations],
 b4_percent_code_get([[requires]])[
 #include <iostream>
 #include <stdexcept>
-#include <string>
+#include <string>]b4_bison_locations_if([b4_location_compact_if([[
+#include <vector>]])])[
 
 ]b4_cxx_portability[
 ]m4_ifdef([b4_location_include],
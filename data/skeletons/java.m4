@@ -304,6 +304,22 @@ b4_percent_define_check_kind([[throws]],            [code], [deprecated])
 
 m4_define([b4_yystype], [b4_percent_define_get([[api.value.type]])])
 b4_percent_define_default([[api.value.type]], [[Object]])
+
+# b4_yystype_primitive_if(IF-PRIMITIVE, IF-NOT)
+# ---------------------------------------------
+# Whether api.value.type is a primitive type, in which case the semantic
+# values are not boxed.
+m4_define([b4_yystype_primitive_if],
+[m4_bmatch(b4_yystype,
+           [^\(boolean\|byte\|char\|short\|int\|long\|float\|double\)$],
+           [$1], [$2])])
+
+# b4_yystype_null
+# ---------------
+# The default semantic value.
+m4_define([b4_yystype_null],
+[b4_yystype_primitive_if([m4_if(b4_yystype, [boolean], [false], [0])],
+                         [null])])
 b4_percent_define_default([[api.symbol.prefix]], [[S_]])
 
 # b4_api_prefix, b4_api_PREFIX
@@ -22,12 +22,19 @@ m4_define([b4_value_type_setup_variant])
 
 # parse.lac
 b4_percent_define_default([[parse.lac]], [[none]])
+b4_percent_define_default([[parse.lac.cache]], [[0]])
 b4_percent_define_check_values([[[[parse.lac]], [[full]], [[none]]]])
+b4_percent_define_check_integer([[parse.lac.cache]])
 b4_define_flag_if([lac])
 m4_define([b4_lac_flag],
           [m4_if(b4_percent_define_get([[parse.lac]]),
                  [none], [[0]], [[1]])])
 
+# b4_lac_cache_if([IF-LAC-CHECKS-ARE-CACHED], [IF-NOT])
+m4_define([b4_lac_cache_if],
+[b4_lac_if([m4_bmatch(b4_percent_define_get([[parse.lac.cache]]), [^0*$],
+                      [$2], [$1])], [$2])])
+
 
 # b4_tname_if(TNAME-NEEDED, TNAME-NOT-NEEDED)
 # -------------------------------------------
@@ -238,6 +245,14 @@ m4_define([b4_shared_declarations],
     /// Set the current debugging level.
     void set_debug_level (debug_level_type l);
 #endif
+]b4_parse_stats_if([[
+    /// Print the statistics of the parses since the construction of
+    /// the parser, or the last call to stats_reset, in the format of
+    /// %define tables.profile.
+    void stats (std::ostream& yyo) const;
+    /// Reset the statistics of the parses.
+    void stats_reset ();
+]])[
 
     /// Report a syntax error.]b4_locations_if([[
     /// \param loc    where the syntax error is found.]])[
@@ -356,6 +371,7 @@ m4_define([b4_shared_declarations],
 
     // Tables.
 ]b4_parser_tables_declare[
+]b4_expected_tables_map([b4_integral_parser_table_declare])[
 
 #if ]b4_api_PREFIX[DEBUG
 ]b4_integral_parser_table_declare([rline], [b4_rline],
@@ -455,7 +471,38 @@ m4_define([b4_shared_declarations],
     /// Since yy_lac_check_ is const, this member must be mutable.
     mutable std::vector<state_type> yylac_stack_;
     /// Whether an initial LAC context was established.
-    bool yy_lac_established_;
+    bool yy_lac_established_;]b4_lac_cache_if([[
+
+    /// Constants of the LAC cache.
+    enum
+    {
+      yylac_cache_size_ = ]b4_percent_define_get([[parse.lac.cache]])[, ///< Number of entries.
+      yylac_cache_depth_ = 4 ///< Number of states of the stack in a key.
+    };
+    /// An entry of the LAC cache: the result of yy_lac_check_ for
+    /// \a token on the stacks whose \a depth topmost states are
+    /// \a states, top first.
+    struct lac_cache_entry
+    {
+      state_type states[yylac_cache_depth_];
+      symbol_kind_type token;
+      /// Zero for an empty entry.
+      int depth;
+      bool result;
+    };
+    /// The results of the previous LAC checks.
+    /// Since yy_lac_check_ is const, this member must be mutable.
+    mutable lac_cache_entry yylac_cache_[yylac_cache_size_];]])[
+]])[]b4_parse_stats_if([[
+    /// Statistics of the parses (parse.stats).
+    std::vector<long> yystats_states_;
+    std::vector<long> yystats_rules_;
+    std::ptrdiff_t yystats_max_depth_;
+    long yystats_reallocations_;
+    long yystats_error_pops_;
+    long yystats_error_discards_;]b4_lac_if([[
+    /// Since yy_lac_check_ is const, this member must be mutable.
+    mutable long yystats_lac_;]])[
 ]])[
 
     /// Push a new state on the stack.
@@ -628,8 +675,11 @@ m4_if(b4_prefix, [yy], [],
 #else
 ]b4_lac_if([    :], [m4_ifset([b4_parse_param], [    :])])[
 #endif]b4_lac_if([[
-      yy_lac_established_ (false)]m4_ifset([b4_parse_param], [,])])[]b4_parse_param_cons[
-  {}
+      yy_lac_established_ (false)]b4_lac_cache_if([[,
+      yylac_cache_ ()]])[]m4_ifset([b4_parse_param], [,])])[]b4_parse_param_cons[
+  {]b4_parse_stats_if([[
+    stats_reset ();
+  ]])[}
 
   ]b4_parser_class::~b4_parser_class[ ()
   {}
@@ -763,7 +813,9 @@ m4_if(b4_prefix, [yy], [],
   ]b4_parser_class[::yypush_ (const char* m, YY_MOVE_REF (stack_symbol_type) sym)
   {
     if (m)
-      YY_SYMBOL_PRINT (m, sym);
+      YY_SYMBOL_PRINT (m, sym);]b4_parse_stats_if([[
+    if (stack_type::size_type (yystack_.size ()) == yystack_.capacity ())
+      ++yystats_reallocations_;]])[
     yystack_.push (YY_MOVE (sym));
   }
 
@@ -810,6 +862,35 @@ m4_if(b4_prefix, [yy], [],
     yydebug_ = l;
   }
 #endif // ]b4_api_PREFIX[DEBUG
+]b4_parse_stats_if([[
+  void
+  ]b4_parser_class[::stats (std::ostream& yyo) const
+  {
+    yyo << "# max-depth " << yystats_max_depth_ << '\n'
+        << "# reallocations " << yystats_reallocations_ << '\n'
+        << "# error-pops " << yystats_error_pops_ << '\n'
+        << "# error-discards " << yystats_error_discards_ << '\n';]b4_lac_if([[
+    yyo << "# lac " << yystats_lac_ << '\n';]])[
+    for (std::size_t yyi = 0; yyi < yystats_states_.size (); ++yyi)
+      if (yystats_states_[yyi])
+        yyo << "state " << yyi << ' ' << yystats_states_[yyi] << '\n';
+    for (std::size_t yyi = 0; yyi < yystats_rules_.size (); ++yyi)
+      if (yystats_rules_[yyi])
+        yyo << "rule " << yyi << ' ' << yystats_rules_[yyi] << '\n';
+  }
+
+  void
+  ]b4_parser_class[::stats_reset ()
+  {
+    yystats_states_.assign (]b4_states_number[, 0);
+    yystats_rules_.assign (]b4_rules_number[, 0);
+    yystats_max_depth_ = 0;
+    yystats_reallocations_ = 0;
+    yystats_error_pops_ = 0;
+    yystats_error_discards_ = 0;]b4_lac_if([[
+    yystats_lac_ = 0;]])[
+  }
+]])[
 
   ]b4_parser_class[::state_type
   ]b4_parser_class[::yy_lr_goto_state_ (state_type yystate, int yysym)
@@ -886,7 +967,10 @@ b4_dollar_popdef])[]dnl
   `-----------------------------------------------*/
   yynewstate:
     YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
-    YY_STACK_PRINT ();
+    YY_STACK_PRINT ();]b4_parse_stats_if([[
+    ++yystats_states_[std::size_t (yystack_[0].state)];
+    if (yystats_max_depth_ < yystack_.size ())
+      yystats_max_depth_ = yystack_.size ();]])[
 
     // Accept?
     if (yystack_[0].state == yyfinal_)
@@ -1012,7 +1096,8 @@ b4_dollar_popdef])[]dnl
       }]])[
 
       // Perform the reduction.
-      YY_REDUCE_PRINT (yyn);
+      YY_REDUCE_PRINT (yyn);]b4_parse_stats_if([[
+      ++yystats_rules_[std::size_t (yyn - 1)];]])[
 #if YY_EXCEPTIONS
       try
 #endif // YY_EXCEPTIONS
@@ -1074,7 +1159,8 @@ b4_dollar_popdef])[]dnl
           YYABORT;
         else if (!yyla.empty ())
           {
-            yy_destroy_ ("Error: discarding", yyla);
+            yy_destroy_ ("Error: discarding", yyla);]b4_parse_stats_if([[
+            ++yystats_error_discards_;]])[
             yyla.clear ();
           }
       }
@@ -1126,7 +1212,8 @@ b4_dollar_popdef])[]dnl
           YYABORT;
 ]b4_locations_if([[
         yyerror_range[1].location = yystack_[0].location;]])[
-        yy_destroy_ ("Error: popping", yystack_[0]);
+        yy_destroy_ ("Error: popping", yystack_[0]);]b4_parse_stats_if([[
+        ++yystats_error_pops_;]])[
         yypop_ ();
         YY_STACK_PRINT ();
       }
@@ -1316,7 +1403,18 @@ b4_dollar_popdef])[]dnl
             else
               yyarg[yycount++] = yysym;
           }
-      }]], [[
+      }]], [b4_expected_tables_if([[
+    const int yystate = yyparser_.yystack_[0].state;
+    const int yyend = yyexpected_index_[yystate + 1];
+    if (!yyarg)
+      yycount = yyend - yyexpected_index_[yystate];
+    else
+      for (int yyi = yyexpected_index_[yystate]; yyi < yyend; ++yyi)
+        if (yycount == yyargn)
+          return 0;
+        else
+          yyarg[yycount++] = YY_CAST (symbol_kind_type, yyexpected_tokens_[yyi]);
+]], [[
     const int yyn = yypact_[+yyparser_.yystack_[0].state];
     if (!yy_pact_value_is_default_ (yyn))
       {
@@ -1339,7 +1437,7 @@ b4_dollar_popdef])[]dnl
                 yyarg[yycount++] = YY_CAST (symbol_kind_type, yyx);
             }
       }
-]])[
+]])])[
     if (yyarg && yycount == 0 && 0 < yyargn)
       yyarg[0] = ]b4_symbol(empty, kind)[;
     return yycount;
@@ -1353,12 +1451,33 @@ b4_dollar_popdef])[]dnl
   {
     // Logically, the yylac_stack's lifetime is confined to this function.
     // Clear it, to get rid of potential left-overs from previous call.
-    yylac_stack_.clear ();
+    yylac_stack_.clear ();]b4_parse_stats_if([[
+    ++yystats_lac_;]])[
     // Reduce until we encounter a shift and thereby accept the token.
 #if ]b4_api_PREFIX[DEBUG
     YYCDEBUG << "LAC: checking lookahead " << symbol_name (yytoken) << ':';
-#endif
+#endif]b4_lac_cache_if([[
+    // The result depends only on the token, and on the states of the
+    // stack inspected by the simulation, yystack_[0] to
+    // yystack_[lac_top].
+    lac_cache_entry& yyentry
+      = yylac_cache_[(std::size_t (yystack_[0].state) * YYNTOKENS
+                      + std::size_t (yytoken)) % yylac_cache_size_];
+    if (yyentry.depth && yyentry.token == yytoken
+        && yyentry.depth <= int (yystack_.size ()))
+      {
+        int yyi = 0;
+        while (yyi < yyentry.depth
+               && yyentry.states[yyi] == yystack_[yyi].state)
+          ++yyi;
+        if (yyi == yyentry.depth)
+          {
+            YYCDEBUG << (yyentry.result ? " Cached S\n" : " Cached Err\n");
+            return yyentry.result;
+          }
+      }]])[
     std::ptrdiff_t lac_top = 0;
+    bool yyresult;
     while (true)
       {
         state_type top_state = (yylac_stack_.empty ()
@@ -1374,7 +1493,8 @@ b4_dollar_popdef])[]dnl
             if (yyrule == 0)
               {
                 YYCDEBUG << " Err\n";
-                return false;
+                yyresult = false;
+                break;
               }
           }
         else
@@ -1384,12 +1504,14 @@ b4_dollar_popdef])[]dnl
             if (yy_table_value_is_error_ (yyrule))
               {
                 YYCDEBUG << " Err\n";
-                return false;
+                yyresult = false;
+                break;
               }
             if (0 < yyrule)
               {
                 YYCDEBUG << " S" << yyrule << '\n';
-                return true;
+                yyresult = true;
+                break;
               }
             yyrule = -yyrule;
           }
@@ -1422,7 +1544,16 @@ b4_dollar_popdef])[]dnl
         state_type state = yy_lr_goto_state_ (top_state, yyr1_[yyrule]);
         YYCDEBUG << " G" << int (state);
         yylac_stack_.push_back (state);
-      }
+      }]b4_lac_cache_if([[
+    if (lac_top < yylac_cache_depth_)
+      {
+        yyentry.token = yytoken;
+        yyentry.depth = int (lac_top) + 1;
+        for (int yyi = 0; yyi < yyentry.depth; ++yyi)
+          yyentry.states[yyi] = yystack_[yyi].state;
+        yyentry.result = yyresult;
+      }]])[
+    return yyresult;
   }
 
   // Establish the initial context if no initial context currently exists.
@@ -1581,7 +1712,7 @@ b4_dollar_popdef])[]dnl
   const ]b4_int_type(b4_table_ninf, b4_table_ninf) b4_parser_class::yytable_ninf_ = b4_table_ninf[;
 
 ]b4_parser_tables_define[
-
+]b4_expected_tables_map([b4_integral_parser_table_define])[
 ]b4_parse_error_bmatch([simple\|verbose],
 [[#if ]b4_api_PREFIX[DEBUG]b4_tname_if([[ || 1]])[
   // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
@@ -66,7 +66,7 @@ m4_define([b4_define_state],
     int yyn = 0;
     int yylen = 0;
     int yystate = 0;
-    YYStack yystack = new YYStack ();
+    YYStack yystack = ]b4_push_if([[new YYStack ()]], [[yystack_]])[;
     int label = YYNEWSTATE;
 
 ]b4_locations_if([[
@@ -77,7 +77,7 @@ m4_define([b4_define_state],
     ]b4_location_type[ yylloc = new ]b4_location_type[ (null, null);]])[
 
     /* Semantic value of the lookahead.  */
-    ]b4_yystype[ yylval = null;
+    ]b4_yystype[ yylval = ]b4_yystype_null[;
 ]])
 
 # parse.lac
@@ -370,6 +370,11 @@ import java.util.ArrayList;
     public int size = 16;
     public int height = -1;
 
+    /** Empty the stack, but keep its storage for the next parse.  */
+    public final void clear() {
+      pop(height + 1);
+    }
+
     public final void push(int state, ]b4_yystype[ value]b4_locations_if([, ]b4_location_type[ loc])[) {
       height++;
       if (size == height) {
@@ -396,12 +401,15 @@ import java.util.ArrayList;
       pop(1);
     }
 
-    public final void pop(int num) {
+    public final void pop(int num) {]b4_yystype_primitive_if([b4_locations_if([[
+      // Avoid memory leaks... garbage collection is a white lie!
+      if (0 < num)
+        java.util.Arrays.fill(locStack, height - num + 1, height + 1, null);]])], [[
       // Avoid memory leaks... garbage collection is a white lie!
       if (0 < num) {
         java.util.Arrays.fill(valueStack, height - num + 1, height + 1, null);]b4_locations_if([[
         java.util.Arrays.fill(locStack, height - num + 1, height + 1, null);]])[
-      }
+      }]])[
       height -= num;
     }
 
@@ -468,7 +476,23 @@ import java.util.ArrayList;
 
   private int yyerrstatus_ = 0;
 
-]b4_push_if([b4_define_state])[
+]b4_push_if([b4_define_state], [[
+  /** The stack, kept from one parse to the next to save allocations.  */
+  private final YYStack yystack_ = new YYStack ();
+]])[
+  /**
+   * Release the semantic values and locations held by the parser, and
+   * prepare it for a new input]b4_push_if([[, even if the current parse is
+   * not finished]])[.  The parser keeps its stack for the next parse.
+   */
+  public void reset ()
+  {]b4_push_if([[
+    push_parse_initialized = false;]])[
+    yystack]b4_push_if([], [_])[.clear ();
+    yyerrstatus_ = 0;
+    yynerrs = 0;
+  }
+
   /**
    * Whether error recovery is being done.  In this state, the parser
    * reads token until it reaches a known state, and then restarts normal
@@ -532,7 +556,8 @@ import java.util.ArrayList;
                    + (yykind.getCode() < YYNTOKENS_ ? " token " : " nterm ")
                    + yykind.getName() + " ("]b4_locations_if([
                    + yylocation + ": "])[
-                   + (yyvalue == null ? "(null)" : yyvalue.toString()) + ")");
+                   + ]b4_yystype_primitive_if([[yyvalue]],
+                                              [[(yyvalue == null ? "(null)" : yyvalue.toString())]])[ + ")");
       }
   }]])[
 
@@ -571,6 +596,7 @@ import java.util.ArrayList;
     yynerrs = 0;
 
     /* Initialize the stack.  */
+    yystack.clear ();
     yystack.push (yystate, yylval]b4_locations_if([, yylloc])[);
 ]m4_ifdef([b4_initial_action], [
 b4_dollar_pushdef([yylval], [], [], [yylloc])dnl
@@ -606,8 +632,7 @@ b4_dollar_popdef[]dnl
 
         /* Accept?  */
         if (yystate == YYFINAL_)
-          ]b4_push_if([{label = YYACCEPT; break;}],
-                      [return true;])[
+          {label = YYACCEPT; break;}
 
         /* Take a decision.  First try without lookahead.  */
         yyn = yypact_[yystate];
@@ -744,7 +769,7 @@ b4_dollar_popdef[]dnl
               {
                 /* Return failure if at end of input.  */
                 if (yychar == Lexer.]b4_symbol(eof, id)[)
-                  ]b4_push_if([{label = YYABORT; break;}], [return false;])[
+                  {label = YYABORT; break;}
               }
             else
               yychar = YYEMPTY_;
@@ -793,7 +818,7 @@ b4_dollar_popdef[]dnl
             /* Pop the current state because it cannot handle the
              * error token.  */
             if (yystack.height == 0)
-              ]b4_push_if([{label = YYABORT; break;}],[return false;])[
+              {label = YYABORT; break;}
 
 ]b4_locations_if([[
             yyerrloc = yystack.locationAt (0);]])[
@@ -809,8 +834,8 @@ b4_dollar_popdef[]dnl
 
 ]b4_locations_if([[
         /* Muck with the stack to setup for yylloc.  */
-        yystack.push (0, null, yylloc);
-        yystack.push (0, null, yyerrloc);
+        yystack.push (0, ]b4_yystype_null[, yylloc);
+        yystack.push (0, ]b4_yystype_null[, yyerrloc);
         yyloc = yylloc (yystack, 2);
         yystack.pop (2);]])[
 
@@ -825,14 +850,17 @@ b4_dollar_popdef[]dnl
         break;
 
         /* Accept.  */
-      case YYACCEPT:
-        ]b4_push_if([this.push_parse_initialized = false; return YYACCEPT;],
-                    [return true;])[
+      case YYACCEPT:]b4_push_if([[
+        this.push_parse_initialized = false;]])[
+        /* Release the semantic values, but keep the stack.  */
+        yystack.clear ();
+        return ]b4_push_if([[YYACCEPT]], [[true]])[;
 
         /* Abort.  */
-      case YYABORT:
-        ]b4_push_if([this.push_parse_initialized = false; return YYABORT;],
-                    [return false;])[
+      case YYABORT:]b4_push_if([[
+        this.push_parse_initialized = false;]])[
+        yystack.clear ();
+        return ]b4_push_if([[YYABORT]], [[false]])[;
       }
 }
 ]b4_push_if([[
@@ -851,7 +879,7 @@ b4_dollar_popdef[]dnl
     this.yyn = 0;
     this.yylen = 0;
     this.yystate = 0;
-    this.yystack = new YYStack();]b4_lac_if([[
+    this.yystack.clear ();]b4_lac_if([[
     this.yylacStack = new ArrayList<Integer>();
     this.yylacEstablished = false;]])[
     this.label = YYNEWSTATE;
@@ -863,7 +891,7 @@ b4_dollar_popdef[]dnl
     this.yylloc = new ]b4_location_type[ (null, null);]])[
 
     /* Semantic value of the lookahead.  */
-    this.yylval = null;
+    this.yylval = ]b4_yystype_null[;
 
     yystack.push (this.yystate, this.yylval]b4_locations_if([, this.yylloc])[);
 
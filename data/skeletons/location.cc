@@ -58,10 +58,298 @@ b4_header_if(
 
 
 
+# b4_location_compact_define
+# --------------------------
+# Define the position and location classes when api.location.compact
+# is enabled: positions are byte offsets, and line and column numbers
+# are computed on demand by a line_index.
+m4_define([b4_location_compact_define],
+[[  /// A point in a source file, as a byte offset.
+  class position
+  {
+  public:
+    /// Type for byte offsets, line and column numbers.
+    typedef int counter_type;
+]m4_ifdef([b4_location_constructors], [[
+    /// Construct a position.
+    explicit position (counter_type o = 0)
+      : offset (o)
+    {}
+
+]])[
+    /// Initialization.
+    void initialize (counter_type o = 0)
+    {
+      offset = o;
+    }
+
+    /** \name Line and Column related manipulators
+     ** \{ */
+    /// (line related) Advance over COUNT end-of-line bytes.
+    void lines (counter_type count = 1)
+    {
+      offset += count;
+    }
+
+    /// (column related) Advance over COUNT bytes.
+    void columns (counter_type count = 1)
+    {
+      offset += count;
+    }
+    /** \} */
+
+    /// Byte offset from the beginning of the input.
+    counter_type offset;
+  };
+
+  /// Add \a width bytes, in place.
+  inline position&
+  operator+= (position& res, position::counter_type width)
+  {
+    res.columns (width);
+    return res;
+  }
+
+  /// Add \a width bytes.
+  inline position
+  operator+ (position res, position::counter_type width)
+  {
+    return res += width;
+  }
+
+  /// Subtract \a width bytes, in place.
+  inline position&
+  operator-= (position& res, position::counter_type width)
+  {
+    return res += -width;
+  }
+
+  /// Subtract \a width bytes.
+  inline position
+  operator- (position res, position::counter_type width)
+  {
+    return res -= width;
+  }
+]b4_percent_define_flag_if([[define_location_comparison]], [[
+  /// Compare two position objects.
+  inline bool
+  operator== (const position& pos1, const position& pos2)
+  {
+    return pos1.offset == pos2.offset;
+  }
+
+  /// Compare two position objects.
+  inline bool
+  operator!= (const position& pos1, const position& pos2)
+  {
+    return !(pos1 == pos2);
+  }
+]])[
+  /** \brief Intercept output stream redirection.
+   ** \param ostr the destination output stream
+   ** \param pos a reference to the position to redirect
+   */
+  template <typename YYChar>
+  std::basic_ostream<YYChar>&
+  operator<< (std::basic_ostream<YYChar>& ostr, const position& pos)
+  {
+    return ostr << pos.offset;
+  }
+
+  /// Two points in a source file.
+  class location
+  {
+  public:
+    /// Type for byte offsets, line and column numbers.
+    typedef position::counter_type counter_type;
+]m4_ifdef([b4_location_constructors], [
+    /// Construct a location from \a b to \a e.
+    location (const position& b, const position& e)
+      : begin (b)
+      , end (e)
+    {}
+
+    /// Construct a 0-width location in \a p.
+    explicit location (const position& p = position ())
+      : begin (p)
+      , end (p)
+    {}
+
+])[
+    /// Initialization.
+    void initialize (counter_type o = 0)
+    {
+      begin.initialize (o);
+      end = begin;
+    }
+
+    /** \name Line and Column related manipulators
+     ** \{ */
+  public:
+    /// Reset initial location to final location.
+    void step ()
+    {
+      begin = end;
+    }
+
+    /// Extend the current location over the COUNT next bytes.
+    void columns (counter_type count = 1)
+    {
+      end += count;
+    }
+
+    /// Extend the current location over COUNT end-of-line bytes.
+    void lines (counter_type count = 1)
+    {
+      end.lines (count);
+    }
+    /** \} */
+
+
+  public:
+    /// Beginning of the located region.
+    position begin;
+    /// End of the located region.
+    position end;
+  };
+
+  /// Join two locations, in place.
+  inline location&
+  operator+= (location& res, const location& end)
+  {
+    res.end = end.end;
+    return res;
+  }
+
+  /// Join two locations.
+  inline location
+  operator+ (location res, const location& end)
+  {
+    return res += end;
+  }
+
+  /// Add \a width bytes to the end position, in place.
+  inline location&
+  operator+= (location& res, location::counter_type width)
+  {
+    res.columns (width);
+    return res;
+  }
+
+  /// Add \a width bytes to the end position.
+  inline location
+  operator+ (location res, location::counter_type width)
+  {
+    return res += width;
+  }
+
+  /// Subtract \a width bytes to the end position, in place.
+  inline location&
+  operator-= (location& res, location::counter_type width)
+  {
+    return res += -width;
+  }
+
+  /// Subtract \a width bytes to the end position.
+  inline location
+  operator- (location res, location::counter_type width)
+  {
+    return res -= width;
+  }
+]b4_percent_define_flag_if([[define_location_comparison]], [[
+  /// Compare two location objects.
+  inline bool
+  operator== (const location& loc1, const location& loc2)
+  {
+    return loc1.begin == loc2.begin && loc1.end == loc2.end;
+  }
+
+  /// Compare two location objects.
+  inline bool
+  operator!= (const location& loc1, const location& loc2)
+  {
+    return !(loc1 == loc2);
+  }
+]])[
+  /** \brief Intercept output stream redirection.
+   ** \param ostr the destination output stream
+   ** \param loc a reference to the location to redirect
+   **
+   ** Print the offsets of the first and last bytes.
+   */
+  template <typename YYChar>
+  std::basic_ostream<YYChar>&
+  operator<< (std::basic_ostream<YYChar>& ostr, const location& loc)
+  {
+    ostr << loc.begin;
+    if (loc.begin.offset + 1 < loc.end.offset)
+      ostr << '-' << loc.end.offset - 1;
+    return ostr;
+  }
+
+  /// The offsets of the beginnings of the lines, to compute the line
+  /// and column numbers of positions only when they are needed.
+  class line_index
+  {
+  public:
+    /// Type for byte offsets, line and column numbers.
+    typedef position::counter_type counter_type;
+
+    /// Record that a new line begins at \a offset.  Offsets must be
+    /// recorded in increasing order.
+    void add (counter_type offset)
+    {
+      starts_.push_back (offset);
+    }
+
+    /// The line number of \a pos.
+    counter_type line (const position& pos) const
+    {
+      return ]b4_location_initial_line[ + counter_type (find_ (pos.offset));
+    }
+
+    /// The column number of \a pos.
+    counter_type column (const position& pos) const
+    {
+      size_type n = find_ (pos.offset);
+      counter_type res = ]b4_location_initial_column[ + pos.offset;
+      if (n)
+        res -= starts_[n - 1];
+      return res;
+    }
+
+  private:
+    /// Type for indexes in starts_.
+    typedef std::vector<counter_type>::size_type size_type;
+
+    /// The number of lines after the first one that begin at or
+    /// before \a offset.
+    size_type find_ (counter_type offset) const
+    {
+      size_type lo = 0;
+      size_type hi = starts_.size ();
+      while (lo < hi)
+        {
+          size_type mid = lo + (hi - lo) / 2;
+          if (starts_[mid] <= offset)
+            lo = mid + 1;
+          else
+            hi = mid;
+        }
+      return lo;
+    }
+
+    /// The offsets of the beginnings of the lines after the first one.
+    std::vector<counter_type> starts_;
+  };
+]])
+
+
 # b4_location_define
 # ------------------
 # Define the position and location classes.
 m4_define([b4_location_define],
+[b4_location_compact_if([b4_location_compact_define],
 [[  /// A point in a source file.
   class position
   {
@@ -335,7 +623,7 @@ m4_define([b4_location_define],
       ostr << '-' << end_col;
     return ostr;
   }
-]])
+]])])
 
 
 m4_ifdef([b4_position_file], [[
@@ -365,7 +653,8 @@ m4_ifdef([b4_location_file], [[
 ]b4_cpp_guard_open([b4_location_path])[
 
 # include <iostream>
-# include <string>
+# include <string>]b4_location_compact_if([[
+# include <vector>]])[
 
 ]b4_null_define[
 
@@ -98,6 +98,13 @@ m4_define([b4_stack_define],
         return index_type (seq_.size ());
       }
 
+      /// Number of elements the stack can hold without reallocating.
+      size_type
+      capacity () const YY_NOEXCEPT
+      {
+        return seq_.capacity ();
+      }
+
       /// Iterator on top of the stack (going downwards).
       const_iterator
       begin () const YY_NOEXCEPT
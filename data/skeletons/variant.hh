@@ -27,6 +27,35 @@ m4_define([b4_assert],
           [b4_api_PREFIX[]_ASSERT])
 
 
+# b4_value_boxed_if([IF-LARGE-VALUES-ARE-ON-THE-HEAP], [IF-NOT])
+# ------------------------------------------------------------
+# Whether api.value.inline-max is defined: semantic values larger than
+# it are not stored in the buffer of value_type, but on the heap.
+m4_define([b4_value_boxed_if],
+[b4_percent_define_ifdef([[api.value.inline-max]], [$1], [$2])])
+
+b4_percent_define_check_integer([[api.value.inline-max]])
+
+
+# b4_value_fits(TYPE)
+# -------------------
+# A C++ condition checking that value_type can hold a TYPE.
+m4_define([b4_value_fits],
+[b4_value_boxed_if([yyboxed_<$1>::value || ])sizeof ($1) <= size])
+
+
+# b4_value_new(ARGS)
+# ------------------
+# Build a T from ARGS in value_type, and expand to its address.  Values
+# stored on the heap are built by a new-expression, which releases the
+# memory if the constructor throws.
+m4_define([b4_value_new],
+[b4_value_boxed_if([[(yyboxed_<T>::value
+              ? static_cast<T*> (yyptr_ = new T ($1))
+              : new (yyas_<T> ()) T ($1))]],
+[[new (yyas_<T> ()) T ($1)]])])
+
+
 # b4_symbol_variant(YYTYPE, YYVAL, ACTION, [ARGS])
 # ------------------------------------------------
 # Run some ACTION ("build", or "destroy") on YYVAL of symbol type
@@ -65,12 +94,12 @@ dummy[]_b4_char_sizeof_counter])
 #    char dummy1[sizeof (type_name_1)];
 #    char dummy2[sizeof (type_name_2)];
 #
-# for defined type names.
+# for defined type names.  Types stored on the heap take no room.
 m4_define([b4_char_sizeof],
 [b4_symbol_if([$1], [has_type],
 [
 m4_map([      b4_symbol_tag_comment], [$@])dnl
-      char _b4_char_sizeof_dummy@{sizeof (b4_symbol([$1], [type]))@};
+      char _b4_char_sizeof_dummy@{b4_value_boxed_if([yyboxed_< b4_symbol([$1], [type]) >::value ? 1 : ])sizeof (b4_symbol([$1], [type]))@};
 ])])
 
 
@@ -118,8 +147,8 @@ m4_define([b4_value_type_declare],
     value_type (YY_RVREF (T) t)]b4_parse_assert_if([
       : yytypeid_ (&typeid (T))])[
     {]b4_parse_assert_if([[
-      ]b4_assert[ (sizeof (T) <= size);]])[
-      new (yyas_<T> ()) T (YY_MOVE (t));
+      ]b4_assert[ (]b4_value_fits([T])[);]])[
+      ]b4_value_new([YY_MOVE (t)])[;
     }
 
 #if 201103L <= YY_CPLUSPLUS
@@ -142,9 +171,9 @@ m4_define([b4_value_type_declare],
     emplace (U&&... u)
     {]b4_parse_assert_if([[
       ]b4_assert[ (!yytypeid_);
-      ]b4_assert[ (sizeof (T) <= size);
+      ]b4_assert[ (]b4_value_fits([T])[);
       yytypeid_ = & typeid (T);]])[
-      return *new (yyas_<T> ()) T (std::forward <U>(u)...);
+      return *]b4_value_new([std::forward <U>(u)...])[;
     }
 # else
     /// Instantiate an empty \a T in here.
@@ -153,9 +182,9 @@ m4_define([b4_value_type_declare],
     emplace ()
     {]b4_parse_assert_if([[
       ]b4_assert[ (!yytypeid_);
-      ]b4_assert[ (sizeof (T) <= size);
+      ]b4_assert[ (]b4_value_fits([T])[);
       yytypeid_ = & typeid (T);]])[
-      return *new (yyas_<T> ()) T ();
+      return *]b4_value_new([])[;
     }
 
     /// Instantiate a \a T in here from \a t.
@@ -164,9 +193,9 @@ m4_define([b4_value_type_declare],
     emplace (const T& t)
     {]b4_parse_assert_if([[
       ]b4_assert[ (!yytypeid_);
-      ]b4_assert[ (sizeof (T) <= size);
+      ]b4_assert[ (]b4_value_fits([T])[);
       yytypeid_ = & typeid (T);]])[
-      return *new (yyas_<T> ()) T (t);
+      return *]b4_value_new([t])[;
     }
 # endif
 
@@ -195,7 +224,7 @@ m4_define([b4_value_type_declare],
     {]b4_parse_assert_if([[
       ]b4_assert[ (yytypeid_);
       ]b4_assert[ (*yytypeid_ == typeid (T));
-      ]b4_assert[ (sizeof (T) <= size);]])[
+      ]b4_assert[ (]b4_value_fits([T])[);]])[
       return *yyas_<T> ();
     }
 
@@ -206,7 +235,7 @@ m4_define([b4_value_type_declare],
     {]b4_parse_assert_if([[
       ]b4_assert[ (yytypeid_);
       ]b4_assert[ (*yytypeid_ == typeid (T));
-      ]b4_assert[ (sizeof (T) <= size);]])[
+      ]b4_assert[ (]b4_value_fits([T])[);]])[
       return *yyas_<T> ();
     }
 
@@ -223,7 +252,10 @@ m4_define([b4_value_type_declare],
     swap (self_type& that) YY_NOEXCEPT
     {]b4_parse_assert_if([[
       ]b4_assert[ (yytypeid_);
-      ]b4_assert[ (*yytypeid_ == *that.yytypeid_);]])[
+      ]b4_assert[ (*yytypeid_ == *that.yytypeid_);]])[]b4_value_boxed_if([[
+      if (yyboxed_<T>::value)
+        std::swap (yyptr_, that.yyptr_);
+      else]])[
       std::swap (as<T> (), that.as<T> ());
     }
 
@@ -233,7 +265,12 @@ m4_define([b4_value_type_declare],
     template <typename T>
     void
     move (self_type& that)
-    {
+    {]b4_value_boxed_if([[
+      if (yyboxed_<T>::value)
+        {
+          yysteal_<T> (that);
+          return;
+        }]])[
 # if 201103L <= YY_CPLUSPLUS
       emplace<T> (std::move (that.as<T> ()));
 # else
@@ -248,7 +285,12 @@ m4_define([b4_value_type_declare],
     template <typename T>
     void
     move (self_type&& that)
-    {
+    {]b4_value_boxed_if([[
+      if (yyboxed_<T>::value)
+        {
+          yysteal_<T> (that);
+          return;
+        }]])[
       emplace<T> (std::move (that.as<T> ()));
       that.destroy<T> ();
     }
@@ -266,7 +308,10 @@ m4_define([b4_value_type_declare],
     template <typename T>
     void
     destroy ()
-    {
+    {]b4_value_boxed_if([[
+      if (yyboxed_<T>::value)
+        delete yyas_<T> ();
+      else]])[
       as<T> ().~T ();]b4_parse_assert_if([
       yytypeid_ = YY_NULLPTR;])[
     }
@@ -284,7 +329,7 @@ m4_define([b4_value_type_declare],
     T*
     yyas_ () YY_NOEXCEPT
     {
-      void *yyp = yyraw_;
+      void *yyp = ]b4_value_boxed_if([[yyboxed_<T>::value ? yyptr_ : ]])[yyraw_;
       return static_cast<T*> (yyp);
      }
 
@@ -293,9 +338,29 @@ m4_define([b4_value_type_declare],
     const T*
     yyas_ () const YY_NOEXCEPT
     {
-      const void *yyp = yyraw_;
+      const void *yyp = ]b4_value_boxed_if([[yyboxed_<T>::value ? yyptr_ : ]])[yyraw_;
       return static_cast<const T*> (yyp);
-     }
+     }]b4_value_boxed_if([[
+
+    /// Take the \a T stored on the heap by \a that, without moving it.
+    template <typename T>
+    void
+    yysteal_ (self_type& that) YY_NOEXCEPT
+    {]b4_parse_assert_if([[
+      ]b4_assert[ (!yytypeid_);
+      ]b4_assert[ (that.yytypeid_);
+      ]b4_assert[ (*that.yytypeid_ == typeid (T));
+      yytypeid_ = that.yytypeid_;
+      that.yytypeid_ = YY_NULLPTR;]])[
+      yyptr_ = that.yyptr_;
+    }
+
+    /// Whether values of type \a T are stored on the heap.
+    template <typename T>
+    struct yyboxed_
+    {
+      enum { value = ]b4_percent_define_get([[api.value.inline-max]])[ < sizeof (T) };
+    };]])[
 
     /// An auxiliary type to compute the largest semantic type.
     union union_type
@@ -310,7 +375,9 @@ m4_define([b4_value_type_declare],
       /// Strongest alignment constraints.
       long double yyalign_me_;
       /// A buffer large enough to store any of the semantic values.
-      char yyraw_[size];
+      char yyraw_[size];]b4_value_boxed_if([[
+      /// The address of the semantic values stored on the heap.
+      void *yyptr_;]])[
     };]b4_parse_assert_if([
 
     /// Whether the content is built: if defined, the name of the stored type.
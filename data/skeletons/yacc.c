@@ -77,14 +77,57 @@ b4_use_push_for_pull_if([
 b4_percent_define_default([[parse.lac]], [[none]])
 b4_percent_define_default([[parse.lac.es-capacity-initial]], [[20]])
 b4_percent_define_default([[parse.lac.memory-trace]], [[failures]])
+b4_percent_define_default([[parse.lac.cache]], [[0]])
 b4_percent_define_check_values([[[[parse.lac]], [[full]], [[none]]]],
                                [[[[parse.lac.memory-trace]],
                                  [[failures]], [[full]]]])
+b4_percent_define_check_integer([[parse.lac.cache]])
 b4_define_flag_if([lac])
 m4_define([b4_lac_flag],
           [m4_if(b4_percent_define_get([[parse.lac]]),
                  [none], [[0]], [[1]])])
 
+# b4_lac_cache_if([IF-LAC-CHECKS-ARE-CACHED], [IF-NOT])
+# -----------------------------------------------------
+m4_define([b4_lac_cache_if],
+[b4_lac_if([m4_bmatch(b4_percent_define_get([[parse.lac.cache]]), [^0*$],
+                      [$2], [$1])], [$2])])
+
+## ------------- ##
+## parse.stats.  ##
+## ------------- ##
+
+# The statistics are static variables, which the reentrant parsers
+# would share.
+b4_parse_stats_if([b4_pure_if(
+[b4_complain_at(b4_percent_define_get_loc([[parse.stats]]),
+                [['%s' and '%s' cannot be used together]],
+                [%define parse.stats],
+                [%define api.pure])])])
+
+## ----------------- ##
+## api.token.batch.  ##
+## ----------------- ##
+
+# b4_token_batch_if([IF-TOKENS-ARE-READ-BY-BATCHES], [IF-NOT])
+# ------------------------------------------------------------
+b4_percent_define_if_define([token_batch], [api.token.batch])
+
+
+# b4_yylex_batch_formals
+# ----------------------
+# All the yylex_batch formal arguments.
+m4_define([b4_yylex_batch_formals],
+[[[b4_api_PREFIX[TOKEN *yytokens]], [[yybatch]]], [[int yycapacity], [[YYBATCHSIZE]]]dnl
+m4_ifdef([b4_lex_param], [, ]b4_lex_param)])
+
+
+# b4_yylex_batch
+# --------------
+# Call yylex_batch.
+m4_define([b4_yylex_batch],
+[b4_function_call([yylex_batch], [int], b4_yylex_batch_formals)])
+
 ## ---------------- ##
 ## Default values.  ##
 ## ---------------- ##
@@ -288,7 +331,10 @@ m4_define([b4_declare_parser_state_variables],
     YYPTRDIFF_T yyes_capacity][]m4_ifval([$1],
             [m4_do([ = b4_percent_define_get([[parse.lac.es-capacity-initial]]) < YYMAXDEPTH],
                    [ ? b4_percent_define_get([[parse.lac.es-capacity-initial]])],
-                   [ : YYMAXDEPTH])])[;]])])
+                   [ : YYMAXDEPTH])])[;]b4_lac_cache_if([[
+
+    /* The results of the previous LAC checks.  */
+    yy_lac_cache_t yylac_cache[YYLAC_CACHE_SIZE];]])])])
 
 
 m4_define([b4_macro_define],
@@ -318,7 +364,8 @@ $1([yylsp])])
 $1([yystacksize])[]b4_lac_if([
 $1([yyesa])
 $1([yyes])
-$1([yyes_capacity])])])
+$1([yyes_capacity])])[]b4_lac_cache_if([
+$1([yylac_cache])])])
 
 
 
@@ -339,7 +386,9 @@ typedef struct ]b4_prefix[pstate ]b4_prefix[pstate;
 int ]b4_prefix[parse (]m4_ifset([b4_parse_param], [b4_formals(b4_parse_param)], [void])[);]])[
 int ]b4_prefix[push_parse (]b4_prefix[pstate *ps]b4_pure_if([[,
                   int pushed_char, ]b4_api_PREFIX[STYPE const *pushed_val]b4_locations_if([[, ]b4_api_PREFIX[LTYPE *pushed_loc]])])b4_user_formals[);
-]b4_pull_if([[int ]b4_prefix[pull_parse (]b4_prefix[pstate *ps]b4_user_formals[);]])[
+]b4_pull_if([[int ]b4_prefix[pull_parse (]b4_prefix[pstate *ps]b4_user_formals[);]])[]b4_token_batch_if([[
+int ]b4_prefix[push_parse_batch (]b4_prefix[pstate *ps,
+                        ]b4_api_PREFIX[TOKEN const *tokens, int count]b4_user_formals[);]])[
 ]b4_prefix[pstate *]b4_prefix[pstate_new (void);
 void ]b4_prefix[pstate_delete (]b4_prefix[pstate *ps);
 ]])
@@ -362,6 +411,39 @@ m4_define([b4_declare_yyparse],
 ])
 
 
+# b4_declare_yytoken
+# ------------------
+# Declare YYTOKEN, the type of the tokens read by yylex_batch.
+m4_define([b4_declare_yytoken],
+[b4_token_batch_if([[
+/* A token, as stored by yylex_batch or passed to yypush_parse_batch.  */
+typedef struct ]b4_api_PREFIX[TOKEN ]b4_api_PREFIX[TOKEN;
+struct ]b4_api_PREFIX[TOKEN
+{
+  /* The token kind, as returned by yylex.  */
+  int kind;
+  /* Its semantic value.  */
+  ]b4_api_PREFIX[STYPE value;]b4_locations_if([[
+  /* Its location.  */
+  ]b4_api_PREFIX[LTYPE location;]])[
+};
+]])])
+
+
+# b4_declare_yyparse_stats
+# ------------------------
+m4_define([b4_declare_yyparse_stats],
+[b4_parse_stats_if([[#include <stdio.h>
+
+/* Print the statistics of the parses since the beginning of the
+   program, or the last call to ]b4_prefix[parse_stats_reset, in the
+   format of %define tables.profile.  */
+void ]b4_prefix[parse_stats (FILE *yyo);
+/* Reset the statistics of the parses.  */
+void ]b4_prefix[parse_stats_reset (void);
+]])])
+
+
 # b4_declare_yyerror_and_yylex
 # ----------------------------
 # Comply with POSIX Yacc.
@@ -387,8 +469,10 @@ m4_define([b4_shared_declarations],
 ]b4_percent_code_get([[requires]])[
 ]b4_token_enums_defines[
 ]b4_declare_yylstype[
+]b4_declare_yytoken[
 ]b4_declare_yyerror_and_yylex[
 ]b4_declare_yyparse[
+]b4_declare_yyparse_stats[
 ]b4_percent_code_get([[provides]])[
 ]b4_cpp_guard_close([b4_spec_mapped_header_file])[]dnl
 ])
@@ -443,7 +527,8 @@ b4_output_begin([b4_parser_file_name])[
 m4_if(b4_api_prefix, [yy], [],
 [[/* Substitute the type names.  */
 #define YYSTYPE         ]b4_api_PREFIX[STYPE]b4_locations_if([[
-#define YYLTYPE         ]b4_api_PREFIX[LTYPE]])])[
+#define YYLTYPE         ]b4_api_PREFIX[LTYPE]])b4_token_batch_if([[
+#define YYTOKEN         ]b4_api_PREFIX[TOKEN]])])[
 ]m4_if(b4_prefix, [yy], [],
 [[/* Substitute the variable and function names.  */]b4_pull_if([[
 #define yyparse         ]b4_prefix[parse]])b4_push_if([[
@@ -452,8 +537,10 @@ m4_if(b4_api_prefix, [yy], [],
 #define yypstate_new    ]b4_prefix[pstate_new
 #define yypstate_clear  ]b4_prefix[pstate_clear
 #define yypstate_delete ]b4_prefix[pstate_delete
-#define yypstate        ]b4_prefix[pstate]])[
-#define yylex           ]b4_prefix[lex
+#define yypstate        ]b4_prefix[pstate]b4_token_batch_if([[
+#define yypush_parse_batch ]b4_prefix[push_parse_batch]])])[
+#define yylex           ]b4_prefix[lex]b4_token_batch_if([[
+#define yylex_batch     ]b4_prefix[lex_batch]])[
 #define yyerror         ]b4_prefix[error
 #define yydebug         ]b4_prefix[debug
 #define yynerrs         ]b4_prefix[nerrs]]b4_pure_if([], [[
@@ -739,7 +826,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
   ]b4_table_value_equals([[table]], [[Yyn]], [b4_table_ninf], [YYTABLE_NINF])[
 
 ]b4_parser_tables_define[
-
+]b4_expected_tables_map([b4_integral_parser_table_define])[
 enum { YYENOMEM = -2 };
 
 #define yyerrok         (yyerrstatus = 0)
@@ -776,6 +863,7 @@ enum { YYENOMEM = -2 };
 #define YYERRCODE ]b4_symbol(undef, id)[
 ]b4_locations_if([[
 ]b4_yylloc_default_define[
+]b4_location_line_column_define[
 #define YYRHSLOC(Rhs, K) ((Rhs)[K])
 ]])[
 
@@ -888,7 +976,42 @@ int yydebug;
 
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH ]b4_stack_depth_max[
-#endif]b4_push_if([[
+#endif]b4_token_batch_if([[
+
+/* YYBATCHSIZE -- maximum number of tokens read at once by
+   yylex_batch.  */
+#ifndef YYBATCHSIZE
+# define YYBATCHSIZE 64
+#endif]])[]b4_lac_cache_if([[
+
+/* YYLAC_CACHE_SIZE -- number of entries of the LAC cache.  */
+#define YYLAC_CACHE_SIZE ]b4_percent_define_get([[parse.lac.cache]])[
+
+/* YYLAC_CACHE_DEPTH -- maximum number of states of the stack that a
+   LAC check may inspect to be cached.  */
+#ifndef YYLAC_CACHE_DEPTH
+# define YYLAC_CACHE_DEPTH 4
+#endif
+
+/* An entry of the LAC cache: the result of yy_lac for YYTOKEN on the
+   stacks whose YYDEPTH topmost states are YYSTATES, top first.  */
+typedef struct
+{
+  yy_state_t yystates[YYLAC_CACHE_DEPTH];
+  yysymbol_kind_t yytoken;
+  /* Zero for an empty entry.  */
+  int yydepth;
+  int yyresult;
+} yy_lac_cache_t;]])[]b4_parse_stats_if([[
+
+/* Statistics of the parses (parse.stats).  */
+static long yystats_states[YYNSTATES];
+static long yystats_rules[YYNRULES];
+static long yystats_max_depth;
+static long yystats_reallocations;
+static long yystats_error_pops;
+static long yystats_error_discards;]b4_lac_if([[
+static long yystats_lac;]])])[]b4_push_if([[
 /* Parser data structure.  */
 struct yypstate
   {]b4_declare_parser_state_variables[
@@ -1001,7 +1124,7 @@ do {                                                                    \
                   "LAC: initial context established for %s\n",          \
                   yysymbol_name (yytoken)));                            \
       yy_lac_established = 1;                                           \
-      switch (yy_lac (yyesa, &yyes, &yyes_capacity, yyssp, yytoken))    \
+      switch (yy_lac (]b4_lac_cache_if([[yylac_cache, ]])[yyesa, &yyes, &yyes_capacity, yyssp, yytoken))    \
         {                                                               \
         case YYENOMEM:                                                  \
           YYNOMEM;                                                      \
@@ -1036,27 +1159,59 @@ do {                                                                     \
 # define YY_LAC_DISCARD(Event) yy_lac_established = 0
 #endif
 
-/* Given the stack whose top is *YYSSP, return 0 iff YYTOKEN can
+]b4_lac_cache_if([[/* Empty the LAC cache YYCACHE.  */
+static void
+yy_lac_cache_clear (yy_lac_cache_t *yycache)
+{
+  int yyi;
+  for (yyi = 0; yyi < YYLAC_CACHE_SIZE; ++yyi)
+    yycache[yyi].yydepth = 0;
+}
+
+]])[/* Given the stack whose top is *YYSSP, return 0 iff YYTOKEN can
    eventually (after perhaps some reductions) be shifted, return 1 if
    not, or return YYENOMEM if memory is exhausted.  As preconditions and
    postconditions: *YYES_CAPACITY is the allocated size of the array to
    which *YYES points, and either *YYES = YYESA or *YYES points to an
    array allocated with YYSTACK_ALLOC.  yy_lac may overwrite the
    contents of either array, alter *YYES and *YYES_CAPACITY, and free
-   any old *YYES other than YYESA.  */
+   any old *YYES other than YYESA.]b4_lac_cache_if([[
+
+   The result depends only on YYTOKEN and on the states of the stack
+   that the simulation inspects, from *YYSSP down to *YYES_PREV.  When
+   they are at most YYLAC_CACHE_DEPTH, it is saved in YYCACHE, and
+   reused for this token on any stack with the same topmost states.]])[  */
 static int
-yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
+yy_lac (]b4_lac_cache_if([[yy_lac_cache_t *yycache, ]])[yy_state_t *yyesa, yy_state_t **yyes,
         YYPTRDIFF_T *yyes_capacity, yy_state_t *yyssp, yysymbol_kind_t yytoken)
 {
   yy_state_t *yyes_prev = yyssp;
   yy_state_t *yyesp = yyes_prev;
+  int yyresult;]b4_lac_cache_if([[
+  yy_lac_cache_t *yyentry
+    = yycache + (YY_CAST (unsigned, *yyssp) * YYNTOKENS
+                 + YY_CAST (unsigned, yytoken)) % YYLAC_CACHE_SIZE;]])[]b4_parse_stats_if([[
+  ++yystats_lac;]])[
   /* Reduce until we encounter a shift and thereby accept the token.  */
   YYDPRINTF ((stderr, "LAC: checking lookahead %s:", yysymbol_name (yytoken)));
   if (yytoken == ]b4_symbol_prefix[YYUNDEF)
     {
       YYDPRINTF ((stderr, " Always Err\n"));
       return 1;
-    }
+    }]b4_lac_cache_if([[
+  if (yyentry->yydepth && yyentry->yytoken == yytoken)
+    {
+      /* State 0 is only at the bottom of the stacks, so the comparison
+         stops there.  */
+      int yyi = 0;
+      while (yyi < yyentry->yydepth && yyentry->yystates[yyi] == yyssp[-yyi])
+        ++yyi;
+      if (yyi == yyentry->yydepth)
+        {
+          YYDPRINTF ((stderr, " Cached %s\n", yyentry->yyresult ? "Err" : "S"));
+          return yyentry->yyresult;
+        }
+    }]])[
   while (1)
     {
       int yyrule = yypact[+*yyesp];
@@ -1069,7 +1224,8 @@ yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
           if (yyrule == 0)
             {
               YYDPRINTF ((stderr, " Err\n"));
-              return 1;
+              yyresult = 1;
+              break;
             }
         }
       else
@@ -1079,12 +1235,14 @@ yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
           if (yytable_value_is_error (yyrule))
             {
               YYDPRINTF ((stderr, " Err\n"));
-              return 1;
+              yyresult = 1;
+              break;
             }
           if (0 < yyrule)
             {
               YYDPRINTF ((stderr, " S%d\n", yyrule));
-              return 0;
+              yyresult = 0;
+              break;
             }
           yyrule = -yyrule;
         }
@@ -1146,7 +1304,17 @@ yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
           }
         YYDPRINTF ((stderr, " G%d", yystate));
       }
-    }
+    }]b4_lac_cache_if([[
+  if (yyssp - yyes_prev < YYLAC_CACHE_DEPTH)
+    {
+      int yyi;
+      yyentry->yytoken = yytoken;
+      yyentry->yydepth = YY_CAST (int, yyssp - yyes_prev) + 1;
+      for (yyi = 0; yyi < yyentry->yydepth; ++yyi)
+        yyentry->yystates[yyi] = yyssp[-yyi];
+      yyentry->yyresult = yyresult;
+    }]])[
+  return yyresult;
 }]])[
 
 ]b4_parse_error_case([simple], [],
@@ -1157,7 +1325,8 @@ typedef struct
   yy_state_t *yyssp;]b4_lac_if([[
   yy_state_t *yyesa;
   yy_state_t **yyes;
-  YYPTRDIFF_T *yyes_capacity;]])])[
+  YYPTRDIFF_T *yyes_capacity;]b4_lac_cache_if([[
+  yy_lac_cache_t *yylac_cache;]])])])[
   yysymbol_kind_t yytoken;]b4_locations_if([[
   YYLTYPE *yylloc;]])[
 } yypcontext_t;
@@ -1183,7 +1352,7 @@ yypcontext_expected_tokens (const yypcontext_t *yyctx,
     {
       yysymbol_kind_t yysym = YY_CAST (yysymbol_kind_t, yyx);
       if (yysym != ]b4_symbol(error, kind)[ && yysym != ]b4_symbol_prefix[YYUNDEF)
-        switch (yy_lac (]b4_push_if([[yyps->yyesa, &yyps->yyes, &yyps->yyes_capacity, yyps->yyssp, yysym]],
+        switch (yy_lac (]b4_lac_cache_if([b4_push_if([[yyps->yylac_cache, ]], [[yyctx->yylac_cache, ]])])[]b4_push_if([[yyps->yyesa, &yyps->yyes, &yyps->yyes_capacity, yyps->yyssp, yysym]],
                                     [[yyctx->yyesa, yyctx->yyes, yyctx->yyes_capacity, yyctx->yyssp, yysym]])[))
           {
           case YYENOMEM:
@@ -1199,6 +1368,16 @@ yypcontext_expected_tokens (const yypcontext_t *yyctx,
               yyarg[yycount++] = yysym;
           }
     }]],
+[b4_expected_tables_if([[  int yyi = yyexpected_index@{+*]b4_push_if([yyps], [yyctx])[->yyssp@};
+  int yyend = yyexpected_index@{+*]b4_push_if([yyps], [yyctx])[->yyssp + 1@};
+  if (!yyarg)
+    yycount = yyend - yyi;
+  else
+    for (; yyi < yyend; ++yyi)
+      if (yycount == yyargn)
+        return 0;
+      else
+        yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyexpected_tokens[yyi]);]],
 [[  int yyn = yypact@{+*]b4_push_if([yyps], [yyctx])[->yyssp@};
   if (!yypact_value_is_default (yyn))
     {
@@ -1221,7 +1400,7 @@ yypcontext_expected_tokens (const yypcontext_t *yyctx,
             else
               yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
           }
-    }]])[
+    }]])])[
   if (yyarg && yycount == 0 && 0 < yyargn)
     yyarg[0] = ]b4_symbol(empty, kind)[;
   return yycount;
@@ -1525,7 +1704,22 @@ yyparse (]m4_ifset([b4_parse_param], [b4_formals(b4_parse_param)], [void])[)
 
 int
 yypull_parse (yypstate *yyps]b4_user_formals[)
-{
+{]b4_token_batch_if([[
+  YYTOKEN yybatch[YYBATCHSIZE];
+  int yystatus;
+  YY_ASSERT (yyps);
+  do {
+    int yycount = ]b4_yylex_batch[;
+    if (0 < yycount)
+      yystatus = yypush_parse_batch (yyps, yybatch, yycount]b4_user_args[);
+    else
+      {]b4_pure_if([[
+        yystatus = yypush_parse (yyps, ]b4_symbol(eof, [id])[, YY_NULLPTR]b4_locations_if([[, YY_NULLPTR]])b4_user_args[);]], [[
+        yychar = ]b4_symbol(eof, [id])[;
+        yystatus = yypush_parse (yyps]b4_user_args[);]])[
+      }
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;]], [[
   YY_ASSERT (yyps);]b4_pure_if([b4_locations_if([[
   static YYLTYPE yyloc_default][]b4_yyloc_default[;
   YYLTYPE yylloc = yyloc_default;]])])[
@@ -1535,7 +1729,7 @@ yypull_parse (yypstate *yyps]b4_user_formals[)
     int ]])[yychar = ]b4_yylex[;
     yystatus = yypush_parse (yyps]b4_pure_if([[, yychar, &yylval]b4_locations_if([[, &yylloc]])])m4_ifset([b4_parse_param], [, b4_args(b4_parse_param)])[);
   } while (yystatus == YYPUSH_MORE);
-  return yystatus;
+  return yystatus;]])[
 }]])[
 
 ]b4_parse_state_variable_macros([b4_pstate_macro_define])[
@@ -1554,7 +1748,8 @@ yypstate_clear (yypstate *yyps)
 
   /* Initialize the state stack, in case yypcontext_expected_tokens is
      called before the first call to yyparse. */
-  *yyssp = 0;
+  *yyssp = 0;]b4_lac_cache_if([[
+  yy_lac_cache_clear (yylac_cache);]])[
   yyps->yynew = 1;
 }
 
@@ -1597,7 +1792,28 @@ yypstate_delete (yypstate *yyps)
       YYFREE (yyps);]b4_pure_if([], [[
       yypstate_allocated = 0;]])[
     }
-}
+}]b4_token_batch_if([[
+
+/* Push the COUNT tokens of TOKENS, and stop at the first status that
+   is not YYPUSH_MORE.  */
+int
+yypush_parse_batch (yypstate *yyps, YYTOKEN const *yytokens, int yycount]b4_user_formals[)
+{
+  int yystatus = YYPUSH_MORE;
+  int yyi;
+  for (yyi = 0; yyi < yycount && yystatus == YYPUSH_MORE; ++yyi)
+    {]b4_pure_if([b4_locations_if([[
+      /* The initial action may change the location of the first token.  */
+      YYLTYPE yyloc = yytokens[yyi].location;]])[
+      yystatus = yypush_parse (yyps, yytokens[yyi].kind, &yytokens[yyi].value]b4_locations_if([[,
+                               &yyloc]])b4_user_args[);]], [[
+      yychar = yytokens[yyi].kind;
+      yylval = yytokens[yyi].value;]b4_locations_if([[
+      yylloc = yytokens[yyi].location;]])[
+      yystatus = yypush_parse (yyps]b4_user_args[);]])[
+    }
+  return yystatus;
+}]])[
 ]])[
 
 ]b4_push_if([[
@@ -1665,7 +1881,13 @@ yyparse (]m4_ifset([b4_parse_param], [b4_formals(b4_parse_param)], [void])[)]])]
 [[  /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;]])[
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;]])[]b4_token_batch_if([b4_push_if([], [[
+
+  /* The tokens read by yylex_batch: YYBATCH_NEXT is the index of the
+     next one to use, YYBATCH_SIZE the number of tokens read.  */
+  YYTOKEN yybatch[YYBATCHSIZE];
+  int yybatch_next = 0;
+  int yybatch_size = 0;]])])[
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N)]b4_locations_if([, yylsp -= (N)])[)
 
@@ -1687,7 +1909,8 @@ yyparse (]m4_ifset([b4_parse_param], [b4_formals(b4_parse_param)], [void])[)]])]
       break;
     }]])[
 
-  YYDPRINTF ((stderr, "Starting parse\n"));
+  YYDPRINTF ((stderr, "Starting parse\n"));]b4_push_if([], [b4_lac_cache_if([[
+  yy_lac_cache_clear (yylac_cache);]])])[
 
 ]m4_ifdef([b4_start_symbols], [],
 [[  yychar = ]b4_symbol(empty, id)[; /* Cause a token to be read.  */
@@ -1722,7 +1945,10 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
-  YY_STACK_PRINT (yyss, yyssp);
+  YY_STACK_PRINT (yyss, yyssp);]b4_parse_stats_if([[
+  ++yystats_states[yystate];
+  if (yystats_max_depth < yyssp - yyss + 1)
+    yystats_max_depth = YY_CAST (long, yyssp - yyss + 1);]])[
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
@@ -1730,7 +1956,8 @@ yysetstate:
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;]b4_parse_stats_if([[
+      ++yystats_reallocations;]])[
 
 # if defined yyoverflow
       {
@@ -1835,8 +2062,22 @@ yyread_pushed_token:]])[
       if (yypushed_val)
         yylval = *yypushed_val;]b4_locations_if([[
       if (yypushed_loc)
-        yylloc = *yypushed_loc;]])])], [[
-      yychar = ]b4_yylex[;]])[
+        yylloc = *yypushed_loc;]])])], [b4_token_batch_if([[
+      if (yybatch_next == yybatch_size)
+        {
+          yybatch_size = ]b4_yylex_batch[;
+          yybatch_next = 0;
+        }
+      if (yybatch_next < yybatch_size)
+        {
+          yychar = yybatch[yybatch_next].kind;
+          yylval = yybatch[yybatch_next].value;]b4_locations_if([[
+          yylloc = yybatch[yybatch_next].location;]])[
+          ++yybatch_next;
+        }
+      else
+        yychar = ]b4_symbol(eof, [id])[;]], [[
+      yychar = ]b4_yylex[;]])])[
     }
 
   if (yychar <= ]b4_symbol(eof, [id])[)
@@ -1931,7 +2172,8 @@ yyreduce:
 [[  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
   yyerror_range[1] = yyloc;]])[
-  YY_REDUCE_PRINT (yyn);]b4_lac_if([[
+  YY_REDUCE_PRINT (yyn);]b4_parse_stats_if([[
+  ++yystats_rules[yyn - 1];]])[]b4_lac_if([[
   {
     int yychar_backup = yychar;
     switch (yyn)
@@ -1995,7 +2237,7 @@ yyerrlab:
          [custom],
 [[      {
         yypcontext_t yyctx
-          = {]b4_push_if([[yyps]], [[yyssp]b4_lac_if([[, yyesa, &yyes, &yyes_capacity]])])[, yytoken]b4_locations_if([[, &yylloc]])[};]b4_lac_if([[
+          = {]b4_push_if([[yyps]], [[yyssp]b4_lac_if([[, yyesa, &yyes, &yyes_capacity]b4_lac_cache_if([[, yylac_cache]])])])[, yytoken]b4_locations_if([[, &yylloc]])[};]b4_lac_if([[
         if (yychar != ]b4_symbol(empty, id)[)
           YY_LAC_ESTABLISH;]])[
         if (yyreport_syntax_error (&yyctx]m4_ifset([b4_parse_param],
@@ -2006,7 +2248,7 @@ yyerrlab:
 [[      yyerror (]b4_yyerror_args[YY_("syntax error"));]],
 [[      {
         yypcontext_t yyctx
-          = {]b4_push_if([[yyps]], [[yyssp]b4_lac_if([[, yyesa, &yyes, &yyes_capacity]])])[, yytoken]b4_locations_if([[, &yylloc]])[};
+          = {]b4_push_if([[yyps]], [[yyssp]b4_lac_if([[, yyesa, &yyes, &yyes_capacity]b4_lac_cache_if([[, yylac_cache]])])])[, yytoken]b4_locations_if([[, &yylloc]])[};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;]b4_lac_if([[
         if (yychar != ]b4_symbol(empty, id)[)
@@ -2054,7 +2296,8 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval]b4_locations_if([, &yylloc])[]b4_user_args[);
+                      yytoken, &yylval]b4_locations_if([, &yylloc])[]b4_user_args[);]b4_parse_stats_if([[
+          ++yystats_error_discards;]])[
           yychar = ]b4_symbol(empty, id)[;
         }
     }
@@ -2110,7 +2353,8 @@ yyerrlab1:
 
 ]b4_locations_if([[      yyerror_range[1] = *yylsp;]])[
       yydestruct ("Error: popping",
-                  YY_ACCESSING_SYMBOL (yystate), yyvsp]b4_locations_if([, yylsp])[]b4_user_args[);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp]b4_locations_if([, yylsp])[]b4_user_args[);]b4_parse_stats_if([[
+      ++yystats_error_pops;]])[
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2203,7 +2447,40 @@ yypushreturn:]], [[
     yyimpl->yynerrs = yynerrs;]])[
   return yyresult;
 }
-]b4_push_if([b4_parse_state_variable_macros([b4_macro_undef])])[
+]b4_parse_stats_if([[
+
+void
+]b4_prefix[parse_stats (FILE *yyo)
+{
+  int yyi;
+  fprintf (yyo, "# max-depth %ld\n", yystats_max_depth);
+  fprintf (yyo, "# reallocations %ld\n", yystats_reallocations);
+  fprintf (yyo, "# error-pops %ld\n", yystats_error_pops);
+  fprintf (yyo, "# error-discards %ld\n", yystats_error_discards);]b4_lac_if([[
+  fprintf (yyo, "# lac %ld\n", yystats_lac);]])[
+  for (yyi = 0; yyi < YYNSTATES; ++yyi)
+    if (yystats_states[yyi])
+      fprintf (yyo, "state %d %ld\n", yyi, yystats_states[yyi]);
+  for (yyi = 0; yyi < YYNRULES; ++yyi)
+    if (yystats_rules[yyi])
+      fprintf (yyo, "rule %d %ld\n", yyi, yystats_rules[yyi]);
+}
+
+void
+]b4_prefix[parse_stats_reset (void)
+{
+  int yyi;
+  for (yyi = 0; yyi < YYNSTATES; ++yyi)
+    yystats_states[yyi] = 0;
+  for (yyi = 0; yyi < YYNRULES; ++yyi)
+    yystats_rules[yyi] = 0;
+  yystats_max_depth = 0;
+  yystats_reallocations = 0;
+  yystats_error_pops = 0;
+  yystats_error_discards = 0;]b4_lac_if([[
+  yystats_lac = 0;]])[
+}
+]])[]b4_push_if([b4_parse_state_variable_macros([b4_macro_undef])])[
 ]b4_percent_code_get([[epilogue]])[]dnl
 b4_epilogue[]dnl
 b4_output_end
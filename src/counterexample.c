@@ -66,6 +66,10 @@
 /* The time limit before giving up looking for unifying counterexample. */
 static double time_limit = 5.0;
 
+/* The maximum number of search states visited before giving up looking
+   for unifying counterexample.  0 for no limit.  */
+static size_t max_search_states = 0;
+
 #define CUMULATIVE_TIME_LIMIT 120.0
 
 // This is the fastest way to get the tail node from the gl_list API.
@@ -1179,6 +1183,13 @@ unifying_example (state_item_number itm1,
                   goto cex_search_end;
                 }
             }
+          if (max_search_states
+              && max_search_states < hash_get_n_entries (visited))
+            {
+              fprintf (stderr, "search state limit exceeded: %zu\n",
+                       hash_get_n_entries (visited));
+              goto cex_search_end;
+            }
           generate_next_states (ss, conflict1, conflict2);
         }
       gl_sortedlist_remove (ssb_queue,
@@ -1207,6 +1218,42 @@ cex_search_end:;
 
 static xtime_t cumulative_time;
 
+/* The counterexamples reported on stderr (-Wcex), so that they are
+   not searched again for the report (*.output), which also shows them.
+   They are released once printed in the report.  NULL if the
+   counterexamples are not reported twice.  */
+typedef struct
+{
+  state_item_number itm1;
+  state_item_number itm2;
+  symbol_number next_sym;
+  bool shift_reduce;
+  counterexample *cex;
+} cex_cache_entry;
+
+static Hash_table *cex_cache = NULL;
+
+static size_t
+cex_cache_hasher (const cex_cache_entry *e, size_t max)
+{
+  return ((size_t) e->itm1 * 31 * 31 + (size_t) e->itm2 * 31
+          + e->next_sym + e->shift_reduce) % max;
+}
+
+static bool
+cex_cache_comparator (const cex_cache_entry *e1, const cex_cache_entry *e2)
+{
+  return e1->itm1 == e2->itm1 && e1->itm2 == e2->itm2
+    && e1->next_sym == e2->next_sym && e1->shift_reduce == e2->shift_reduce;
+}
+
+static void
+cex_cache_entry_free (cex_cache_entry *e)
+{
+  free_counterexample (e->cex);
+  free (e);
+}
+
 void
 counterexample_init (void)
 {
@@ -1230,7 +1277,34 @@ counterexample_init (void)
       }
     free (cp);
   }
+  // Check cex.max-states.
+  {
+    const char *variable = "cex.max-states";
+    char *cp = muscle_percent_define_get (variable);
+    if (*cp != '\0')
+      {
+        char *end = NULL;
+        errno = 0;
+        long v = strtol (cp, &end, 10);
+        if (*end == '\0' && errno == 0 && v >= 0)
+          max_search_states = v;
+        else
+          {
+            location loc = muscle_percent_define_get_loc (variable);
+            complain (&loc, complaint,
+                      _("invalid value for %%define variable %s: %s"),
+                      quote (variable), quote_n (1, cp));
+          }
+      }
+    free (cp);
+  }
   cumulative_time = gethrxtime ();
+  if (warning_is_enabled (Wcounterexamples) && report_flag
+      && !(feature_flag & feature_syntax_only))
+    cex_cache =
+      hash_xinitialize (32, NULL, (Hash_hasher) cex_cache_hasher,
+                        (Hash_comparator) cex_cache_comparator,
+                        (Hash_data_freer) cex_cache_entry_free);
   scp_set = bitset_create (nstates, BITSET_FIXED);
   rpp_set = bitset_create (nstates, BITSET_FIXED);
   state_items_init ();
@@ -1244,6 +1318,11 @@ counterexample_free (void)
     {
       bitset_free (scp_set);
       bitset_free (rpp_set);
+      if (cex_cache)
+        {
+          hash_free (cex_cache);
+          cex_cache = NULL;
+        }
       state_items_free ();
     }
 }
@@ -1257,6 +1336,20 @@ counterexample_report (state_item_number itm1, state_item_number itm2,
                        symbol_number next_sym, bool shift_reduce,
                        FILE *out, const char *prefix)
 {
+  cex_cache_entry probe = { itm1, itm2, next_sym, shift_reduce, NULL };
+  if (cex_cache)
+    {
+      cex_cache_entry *cached = hash_remove (cex_cache, &probe);
+      if (cached)
+        {
+          if (trace_flag & trace_cex)
+            fputs ("reusing the counterexample reported on stderr\n", stderr);
+          counterexample_print (cached->cex, out, prefix);
+          cex_cache_entry_free (cached);
+          return;
+        }
+    }
+
   // Compute the shortest lookahead-sensitive path and associated sets of
   // parser states.
   state_item_list shortest_path = shortest_path_from_start (itm1, next_sym);
@@ -1284,7 +1377,14 @@ counterexample_report (state_item_number itm1, state_item_number itm2,
 
   gl_list_free (shortest_path);
   counterexample_print (cex, out, prefix);
-  free_counterexample (cex);
+  if (cex_cache && out == stderr)
+    {
+      cex_cache_entry *entry = xmemdup (&probe, sizeof probe);
+      entry->cex = cex;
+      hash_xinsert (cex_cache, entry);
+    }
+  else
+    free_counterexample (cex);
 }
 
 
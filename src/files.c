@@ -59,6 +59,7 @@ char *spec_verbose_file = NULL;  /* for --verbose. */
 char *spec_graph_file = NULL;    /* for -g. */
 char *spec_html_file = NULL;     /* for --html. */
 char *spec_xml_file = NULL;      /* for -x. */
+char *spec_json_file = NULL;     /* for --json. */
 char *spec_header_file = NULL;   /* for --header. */
 char *parser_file_name;
 
@@ -489,6 +490,13 @@ compute_output_file_names (void)
       output_file_name_check (&spec_xml_file, false);
     }
 
+  if (json_flag)
+    {
+      if (! spec_json_file)
+        spec_json_file = concat2 (all_but_tab_ext, ".jsonl");
+      output_file_name_check (&spec_json_file, false);
+    }
+
   if (report_flag)
     {
       if (!spec_verbose_file)
@@ -582,6 +590,7 @@ output_file_names_free (void)
   free (spec_graph_file);
   free (spec_html_file);
   free (spec_xml_file);
+  free (spec_json_file);
   free (spec_header_file);
   free (parser_file_name);
   free (dir_prefix);
@@ -50,6 +50,9 @@ extern char *spec_html_file;
 /* File name specified for the XML output.  */
 extern char *spec_xml_file;
 
+/* File name specified for the JSON Lines output.  */
+extern char *spec_json_file;
+
 /* File name specified with --header.  */
 extern char *spec_header_file;
 
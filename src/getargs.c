@@ -42,6 +42,7 @@ bool header_flag = false;
 bool graph_flag = false;
 bool html_flag = false;
 bool xml_flag = false;
+bool json_flag = false;
 bool no_lines_flag = false;
 bool token_table_flag = false;
 location yacc_loc = EMPTY_LOCATION_INIT;
@@ -446,6 +447,7 @@ Output Files:\n\
   -o, --output=FILE             leave output to FILE\n\
   -g, --graph[=FILE]            also output a graph of the automaton\n\
       --html[=FILE]             also output an HTML report of the automaton\n\
+      --json[=FILE]             also output a JSON Lines report of the automaton\n\
   -x, --xml[=FILE]              also output an XML report of the automaton\n\
   -M, --file-prefix-map=OLD=NEW replace prefix OLD with NEW when writing file paths\n\
                                 in output files\n\
@@ -586,6 +588,7 @@ enum
   COLOR_OPTION = CHAR_MAX + 1,
   FIXED_OUTPUT_FILES_OPTION,
   HTML_OPTION,
+  JSON_OPTION,
   LOCATIONS_OPTION,
   PRINT_DATADIR_OPTION,
   PRINT_LOCALEDIR_OPTION,
@@ -631,6 +634,7 @@ static struct option const long_options[] =
   { "output",          required_argument,   0,   'o' },
   { "graph",           optional_argument,   0,   'g' },
   { "html",            optional_argument,   0,   HTML_OPTION },
+  { "json",            optional_argument,   0,   JSON_OPTION },
   { "xml",             optional_argument,   0,   'x' },
   { "file-prefix-map", required_argument,   0,   'M' },
 
@@ -863,6 +867,15 @@ getargs (int argc, char *argv[])
           }
         break;
 
+      case JSON_OPTION:
+        json_flag = true;
+        if (optarg)
+          {
+            free (spec_json_file);
+            spec_json_file = xstrdup (optarg);
+          }
+        break;
+
       case FIXED_OUTPUT_FILES_OPTION:
         complain (&loc, Wdeprecated,
                   _("deprecated option: %s, use %s"),
@@ -38,6 +38,7 @@ extern bool header_flag;                /* for -d/-H */
 extern bool graph_flag;                 /* for -g */
 extern bool html_flag;                  /* for --html */
 extern bool xml_flag;                   /* for -x */
+extern bool json_flag;                  /* for --json */
 extern bool no_lines_flag;              /* for -l */
 extern bool token_table_flag;           /* for -k */
 extern location yacc_loc;               /* for -y */
@@ -539,6 +539,18 @@ ielr_compute_annotation_lists (bitsetv follow_kernel_items,
                *max_annotationsp);
       fprintf (stderr, "Max number of contributions per annotation: %d\n",
                max_contributions);
+      {
+        int item_lookahead_set_count = 0;
+        for (state_number i = 0; i < nstates; ++i)
+          if (item_lookahead_sets[i])
+            for (size_t j = 0; j < states[i]->nitems; ++j)
+              if (item_lookahead_sets[i][j])
+                ++item_lookahead_set_count;
+        fprintf (stderr, "Number of kernel item lookahead sets: %d\n",
+                 item_lookahead_set_count);
+      }
+      fprintf (stderr, "Memory used by annotations: %zu bytes\n",
+               (size_t) obstack_memory_used (annotations_obstackp));
     }
   for (state_number i = 0; i < nstates; ++i)
     if (item_lookahead_sets[i])
@@ -570,6 +582,19 @@ typedef struct state_list
    */
   struct state_list *lr0Isocore;
   struct state_list *nextIsocore;
+  /**
+   * \c NULL iff not yet computed or stale.  Otherwise,
+   * <tt>dominantContributions[i]</tt> is the result of
+   * \c AnnotationList__computeDominantContribution for annotation \c i of
+   * \c lr0Isocore and the current \c lookaheads.  It must be reset whenever
+   * \c lookaheads changes.
+   */
+  ContributionIndex *dominantContributions;
+  /**
+   * When merging demands identical lookahead sets (canonical LR(1)), the
+   * result of \c ielr_compute_lookaheads_hash on \c lookaheads.
+   */
+  size_t lookaheadsHash;
 } state_list;
 
 MAYBE_UNUSED static void
@@ -590,6 +615,64 @@ state_list_print (const state_list *s, FILE *out)
   fprintf (out, "}");
 }
 
+/**
+ * \pre
+ *   - Either <tt>lookaheads = NULL</tt>, or, for <tt>0 <= i < nitems</tt>,
+ *     <tt>lookaheads[i]</tt> is either \c NULL or a lookahead set.
+ * \post
+ *   - \c result is a hash of the lookahead sets where \c NULL is equivalent
+ *     to an empty set.  In particular, it is 0 if all sets are empty.
+ */
+static size_t
+ielr_compute_lookaheads_hash (bitset *lookaheads, size_t nitems)
+{
+  size_t res = 0;
+  if (lookaheads)
+    for (size_t i = 0; i < nitems; ++i)
+      if (lookaheads[i])
+        {
+          bitset_iterator biter;
+          bitset_bindex token;
+          BITSET_FOR_EACH (biter, lookaheads[i], token, 0)
+            res = (res * 31) ^ (i * ntokens + token + 1);
+        }
+  return res;
+}
+
+/**
+ * \pre
+ *   - \c annotation_lists was computed by \c ielr_compute_annotation_lists.
+ *   - <tt>s->recomputedAsSuccessor</tt>.
+ * \post
+ *   - \c result = <tt>s->dominantContributions</tt>, computed from
+ *     <tt>s->lookaheads</tt> if it was \c NULL.
+ */
+static ContributionIndex const *
+ielr_compute_dominant_contributions (AnnotationList **annotation_lists,
+                                     state_list *s)
+{
+  if (!s->dominantContributions)
+    {
+      state const *lr0_isocore = s->lr0Isocore->state;
+      AnnotationIndex count = 0;
+      for (AnnotationList *a = annotation_lists[lr0_isocore->number];
+           a;
+           a = a->next)
+        ++count;
+      s->dominantContributions =
+        xnmalloc (count, sizeof *s->dominantContributions);
+      AnnotationIndex ai;
+      AnnotationList *a;
+      for (ai = 0, a = annotation_lists[lr0_isocore->number];
+           a;
+           ++ai, a = a->next)
+        s->dominantContributions[ai] =
+          AnnotationList__computeDominantContribution (
+            a, lr0_isocore->nitems, s->lookaheads, false);
+    }
+  return s->dominantContributions;
+}
+
 /**
  * \pre
  *   - \c follow_kernel_items and \c always_follows were computed by
@@ -721,6 +804,11 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
 {
   state_list *lr0_isocore = t->state_list->lr0Isocore;
   state_list **this_isocorep;
+  /* In canonical LR(1), there can be many isocores of t, and they can be
+     merged only if their lookahead sets are identical.  Comparing hashes
+     first avoids comparing the lookahead sets of most of them.  */
+  size_t lookaheads_hash =
+    annotation_lists ? 0 : ielr_compute_lookaheads_hash (lookaheads, t->nitems);
 
   /* Determine whether there's an isocore of t with which these lookaheads can
      be merged.  */
@@ -744,32 +832,34 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
           break;
         if (annotation_lists)
           {
+            /* An isocore is usually compared against many candidates before
+               its lookaheads change again, so its dominant contributions
+               are cached rather than recomputed for each comparison.  */
+            ContributionIndex const *cis =
+              ielr_compute_dominant_contributions (annotation_lists,
+                                                   *this_isocorep);
             AnnotationIndex ai;
             AnnotationList *a;
             for (ai = 0, a = annotation_lists[lr0_isocore->state->number];
                  a;
                  ++ai, a = a->next)
               {
-                if (work1[ai] != ContributionIndex__none)
-                  {
-                    /* This isocore compatibility test depends on the fact
-                       that, if the dominant contributions are the same for the
-                       two isocores, then merging their lookahead sets will not
-                       produce a state with a different dominant contribution.
-                       */
-                    ContributionIndex ci =
-                      AnnotationList__computeDominantContribution (
-                        a, lr0_isocore->state->nitems,
-                        (*this_isocorep)->lookaheads, false);
-                    if (ci != ContributionIndex__none && work1[ai] != ci)
-                      break;
-                  }
+                /* This isocore compatibility test depends on the fact that,
+                   if the dominant contributions are the same for the two
+                   isocores, then merging their lookahead sets will not
+                   produce a state with a different dominant contribution.  */
+                if (work1[ai] != ContributionIndex__none
+                    && cis[ai] != ContributionIndex__none
+                    && work1[ai] != cis[ai])
+                  break;
               }
             if (!a)
               break;
           }
         else
           {
+            if ((*this_isocorep)->lookaheadsHash != lookaheads_hash)
+              continue;
             size_t i;
             for (i = 0; i < t->nitems; ++i)
               {
@@ -805,6 +895,11 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
       bool new_lookaheads = false;
       *tp = (*this_isocorep)->state;
 
+      /* Either the isocore has not been computed yet and is about to
+         receive these lookaheads, or it already has exactly these.  */
+      if (!annotation_lists)
+        (*this_isocorep)->lookaheadsHash = lookaheads_hash;
+
       /* Merge lookaheads into the state and record whether any of them are
          actually new.  */
       if (has_lookaheads)
@@ -830,6 +925,11 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
                   new_lookaheads = true;
               }
         }
+      if (new_lookaheads)
+        {
+          free ((*this_isocorep)->dominantContributions);
+          (*this_isocorep)->dominantContributions = NULL;
+        }
 
       /* If new lookaheads were merged, propagate those lookaheads to the
          successors, possibly splitting them.  If *tp is being recomputed for
@@ -950,6 +1050,8 @@ ielr_compute_state (bitsetv follow_kernel_items, bitsetv always_follows,
         }
       (*last_statep)->lr0Isocore = lr0_isocore;
       (*last_statep)->nextIsocore = old_isocore;
+      (*last_statep)->dominantContributions = NULL;
+      (*last_statep)->lookaheadsHash = lookaheads_hash;
     }
 }
 
@@ -993,6 +1095,8 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
         (*nodep)->lookaheads = NULL;
         (*nodep)->lr0Isocore = *nodep;
         (*nodep)->nextIsocore = *nodep;
+        (*nodep)->dominantContributions = NULL;
+        (*nodep)->lookaheadsHash = 0;
         nodep = &(*nodep)->next;
         if (states[i]->nitems > max_nitems)
           max_nitems = states[i]->nitems;
@@ -1034,6 +1138,26 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
   bitsetv_free (lookahead_filter);
   bitsetv_free (lookaheads);
 
+  if (trace_flag & trace_ielr)
+    {
+      int lookahead_set_count = 0;
+      int cached_contribution_count = 0;
+      for (state_list *node = first_state; node; node = node->next)
+        {
+          if (node->lookaheads)
+            for (size_t i = 0; i < node->state->nitems; ++i)
+              if (node->lookaheads[i])
+                ++lookahead_set_count;
+          if (node->dominantContributions)
+            ++cached_contribution_count;
+        }
+      fprintf (stderr, "Number of split states: %d\n", nstates);
+      fprintf (stderr, "Number of kernel item lookahead sets: %d\n",
+               lookahead_set_count);
+      fprintf (stderr, "Number of cached dominant contribution arrays: %d\n",
+               cached_contribution_count);
+    }
+
   /* Store states back in the states array.  */
   states = xnrealloc (states, nstates, sizeof *states);
   for (state_list *node = first_state; node; node = node->next)
@@ -1090,6 +1214,7 @@ ielr_split_states (bitsetv follow_kernel_items, bitsetv always_follows,
               bitset_free (node->lookaheads[i]);
           free (node->lookaheads);
         }
+      free (node->dominantContributions);
       first_state = node->next;
       free (node);
     }
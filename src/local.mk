@@ -83,6 +83,8 @@ src_bison_SOURCES =                             \
   src/parse-simulation.h                        \
   src/print-graph.c                             \
   src/print-graph.h                             \
+  src/print-json.c                              \
+  src/print-json.h                              \
   src/print-xml.c                               \
   src/print-xml.h                               \
   src/print.c                                   \
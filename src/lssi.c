@@ -21,6 +21,7 @@
 
 #include "lssi.h"
 
+#include <gethrxtime.h>
 #include <gl_linked_list.h>
 #include <gl_xlist.h>
 #include <stdlib.h>
@@ -33,53 +34,72 @@ typedef struct lssi
 {
   state_item_number si;
   struct lssi *parent;
-  // this is the precise lookahead set (follow_L from the CupEx paper)
+  // this is the precise lookahead set (follow_L from the CupEx paper).
+  // Interned: equal sets are the same bitset.
   bitset lookahead;
-  bool free_lookahead;
 } lssi;
 
 static lssi *
-new_lssi (state_item_number si, lssi *p, bitset l, bool free_l)
+new_lssi (state_item_number si, lssi *p, bitset l)
 {
   lssi *res = xmalloc (sizeof *res);
   res->si = si;
   res->parent = p;
   res->lookahead = l;
-  res->free_lookahead = free_l;
   return res;
 }
 
 static void
 lssi_free (lssi *sn)
 {
-  if (sn == NULL)
-    return;
-  if (sn->free_lookahead)
-    bitset_free (sn->lookahead);
   free (sn);
 }
 
 static size_t
 lssi_hasher (lssi *sn, size_t max)
 {
-  size_t hash = sn->si;
+  return ((size_t) sn->si * 31 + (size_t) sn->lookahead / sizeof (void *))
+    % max;
+}
+
+static bool
+lssi_comparator (lssi *s1, lssi *s2)
+{
+  return s1->si == s2->si && s1->lookahead == s2->lookahead;
+}
+
+static size_t
+lookahead_hasher (bitset l, size_t max)
+{
+  size_t hash = 0;
   bitset_iterator biter;
   symbol_number syn;
-  BITSET_FOR_EACH (biter, sn->lookahead, syn, 0)
-    hash += syn;
+  BITSET_FOR_EACH (biter, l, syn, 0)
+    hash = hash * 31 + syn;
   return hash % max;
 }
 
 static bool
-lssi_comparator (lssi *s1, lssi *s2)
+lookahead_comparator (bitset l1, bitset l2)
+{
+  return bitset_equal_p (l1, l2);
+}
+
+/* Return the bitset of LOOKAHEADS that is equal to L, which is
+   added to LOOKAHEADS if there is none.  In the former case, L is
+   freed.  */
+static bitset
+lookahead_intern (Hash_table *lookaheads, bitset l)
 {
-  if (s1->si == s2->si)
+  bitset res = hash_lookup (lookaheads, l);
+  if (res)
+    bitset_free (l);
+  else
     {
-      if (s1->lookahead == s2->lookahead)
-        return true;
-      return bitset_equal_p (s1->lookahead, s2->lookahead);
+      hash_xinsert (lookaheads, l);
+      res = l;
     }
-  return false;
+  return res;
 }
 
 typedef gl_list_t lssi_list;
@@ -89,7 +109,6 @@ append_lssi (lssi *sn, Hash_table *visited, lssi_list queue)
 {
   if (hash_lookup (visited, sn))
     {
-      sn->free_lookahead = false;
       lssi_free (sn);
       return false;
     }
@@ -153,15 +172,24 @@ eligible_state_items (state_item *target)
 state_item_list
 shortest_path_from_start (state_item_number target, symbol_number next_sym)
 {
+  xtime_t start = gethrxtime ();
   bitset eligible = eligible_state_items (&state_items[target]);
   Hash_table *visited = hash_initialize (32,
                                          NULL,
                                          (Hash_hasher) lssi_hasher,
                                          (Hash_comparator) lssi_comparator,
                                          (Hash_data_freer) lssi_free);
+  // Many nodes share the same lookahead set: intern them so that
+  // visited nodes are compared in constant time.
+  Hash_table *lookaheads
+    = hash_initialize (32,
+                       NULL,
+                       (Hash_hasher) lookahead_hasher,
+                       (Hash_comparator) lookahead_comparator,
+                       (Hash_data_freer) bitset_free);
   bitset il = bitset_create (nsyms, BITSET_FIXED);
   bitset_set (il, 0);
-  lssi *init = new_lssi (0, NULL, il, true);
+  lssi *init = new_lssi (0, NULL, lookahead_intern (lookaheads, il));
   lssi_list queue = gl_list_create_empty (GL_LINKED_LIST, NULL, NULL,
                                           NULL, true);
   append_lssi (init, visited, queue);
@@ -184,7 +212,7 @@ shortest_path_from_start (state_item_number target, symbol_number next_sym)
         {
           if (bitset_test (eligible, si->trans))
             {
-              lssi *next = new_lssi (si->trans, n, n->lookahead, false);
+              lssi *next = new_lssi (si->trans, n, n->lookahead);
               append_lssi (next, visited, queue);
             }
         }
@@ -217,8 +245,8 @@ shortest_path_from_start (state_item_number target, symbol_number next_sym)
             }
           if (item_number_is_rule_number (*pos))
             bitset_union (lookahead, n->lookahead, lookahead);
+          lookahead = lookahead_intern (lookaheads, lookahead);
 
-          bool lookahead_used = false;
           // Try all possible production steps within this parser state.
           bitset_iterator biter;
           state_item_number nextSI;
@@ -226,13 +254,9 @@ shortest_path_from_start (state_item_number target, symbol_number next_sym)
             {
               if (!bitset_test (eligible, nextSI))
                 continue;
-              lssi *next = new_lssi (nextSI, n, lookahead,
-                                     !lookahead_used);
-              lookahead_used = append_lssi (next, visited, queue)
-                               || lookahead_used;
+              lssi *next = new_lssi (nextSI, n, lookahead);
+              append_lssi (next, visited, queue);
             }
-          if (!lookahead_used)
-            bitset_free (lookahead);
         }
     }
 
@@ -249,10 +273,13 @@ shortest_path_from_start (state_item_number target, symbol_number next_sym)
     gl_list_add_first (res, &state_items[sn->si]);
 
   hash_free (visited);
+  hash_free (lookaheads);
   gl_list_free (queue);
 
   if (trace_flag & trace_cex)
     {
+      fprintf (stderr, "shortest_path_from_start: %.3fs\n",
+               (gethrxtime () - start) / 1e9);
       fputs ("REDUCE ITEM PATH:\n", stderr);
       gl_list_iterator_t it = gl_list_iterator (res);
       const void *sip;
@@ -48,6 +48,7 @@
 #include "output.h"
 #include "parse-gram.h"
 #include "print-graph.h"
+#include "print-json.h"
 #include "print-xml.h"
 #include "print.h"
 #include "reader.h"
@@ -205,6 +206,14 @@ main (int argc, char *argv[])
           timevar_pop (tv_xml);
         }
 
+      /* Output json.  */
+      if (json_flag)
+        {
+          timevar_push (tv_json);
+          print_json ();
+          timevar_pop (tv_json);
+        }
+
       /* Output html.  */
       if (html_flag)
         {
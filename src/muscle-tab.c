@@ -61,6 +61,11 @@ typedef struct
   char const *key;
   char const *value;
   char *storage;
+  /* If STORAGE is not null, the length of VALUE, and the number of
+     bytes allocated for STORAGE.  STORAGE grows geometrically, so that
+     appending to a muscle many times costs linear time.  */
+  size_t size;
+  size_t capacity;
   muscle_kind kind;
 } muscle_entry;
 
@@ -107,6 +112,8 @@ muscle_entry_new (char const *key)
   res->key = key;
   res->value = NULL;
   res->storage = NULL;
+  res->size = 0;
+  res->capacity = 0;
   hash_xinsert (muscle_table, res);
   return res;
 }
@@ -127,9 +134,13 @@ muscle_init (void)
 
   muscle_table = hash_xinitialize (HT_INITIAL_CAPACITY, NULL, hash_muscle,
                                    hash_compare_muscles, muscle_entry_free);
-  /* Avoid warnings if the user defined this variable, but did not
+  /* Avoid warnings if the user defined these variables, but did not
      actually call -Wcex.  */
+  free (muscle_percent_define_get ("cex.max-states"));
   free (muscle_percent_define_get ("cex.timeout"));
+  /* Likewise for --graph.  */
+  free (muscle_percent_define_get ("graph.radius"));
+  free (muscle_percent_define_get ("graph.states"));
 }
 
 
@@ -165,8 +176,7 @@ muscle_insert (char const *key, char const *value)
 
 
 /* Append VALUE to the current value of KEY.  If KEY did not already
-   exist, create it.  Use MUSCLE_OBSTACK.  De-allocate the previously
-   associated value.  Copy VALUE and SEPARATOR.  If VALUE does not end
+   exist, create it.  Copy VALUE and SEPARATOR.  If VALUE does not end
    with TERMINATOR, append one.  */
 
 static void
@@ -174,28 +184,45 @@ muscle_grow (const char *key, const char *val,
              const char *separator, const char *terminator)
 {
   muscle_entry *entry = muscle_lookup (key);
+  size_t seps = 0;
   if (entry)
-    {
-      obstack_sgrow (&muscle_obstack, entry->value);
-      obstack_sgrow (&muscle_obstack, separator);
-      free (entry->storage);
-    }
+    seps = strlen (separator);
   else
     entry = muscle_entry_new (key);
 
-  obstack_sgrow (&muscle_obstack, val);
+  /* If the current value is not ours, take a copy of it.  */
+  if (!entry->storage)
+    {
+      char const *value = entry->value ? entry->value : "";
+      entry->size = strlen (value);
+      entry->capacity = entry->size + 1;
+      entry->storage = xmemdup (value, entry->capacity);
+    }
 
   size_t vals = strlen (val);
   size_t terms = strlen (terminator);
-  if (terms <= vals
-      && STRNEQ (val + vals - terms, terminator))
-    obstack_sgrow (&muscle_obstack, terminator);
+  if (!(terms <= vals
+        && STRNEQ (val + vals - terms, terminator)))
+    terms = 0;
 
-  {
-    char const *new_val = obstack_finish0 (&muscle_obstack);
-    entry->value = entry->storage = xstrdup (new_val);
-    obstack_free (&muscle_obstack, new_val);
-  }
+  size_t size = entry->size + seps + vals + terms;
+  if (entry->capacity <= size)
+    {
+      entry->capacity *= 2;
+      if (entry->capacity <= size)
+        entry->capacity = size + 1;
+      entry->storage = xrealloc (entry->storage, entry->capacity);
+    }
+  char *cp = entry->storage + entry->size;
+  memcpy (cp, separator, seps);
+  cp += seps;
+  memcpy (cp, val, vals);
+  cp += vals;
+  memcpy (cp, terminator, terms);
+  cp += terms;
+  *cp = '\0';
+  entry->size = size;
+  entry->value = entry->storage;
 }
 
 /*------------------------------------------------------------------.
@@ -649,6 +676,12 @@ muscle_percent_define_get_loc (char const *variable)
   return location_decode (muscle_percent_define_get_raw (variable, "loc"));
 }
 
+char *
+muscle_percent_define_peek (char const *variable)
+{
+  return string_decode (muscle_name (variable, NULL));
+}
+
 char const *
 muscle_percent_define_get_syncline (char const *variable)
 {
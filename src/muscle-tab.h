@@ -176,6 +176,13 @@ location muscle_percent_define_get_loc (char const *variable);
    the output.  */
 char const *muscle_percent_define_get_syncline (char const *variable);
 
+/* The value of the %define variable VARIABLE, or NULL if it is
+   undefined.  Don't record this as a Bison usage of VARIABLE: this is
+   meant to check whether the skeleton will use some muscles, in which
+   case it records the usage itself.  The caller must free the
+   result.  */
+char *muscle_percent_define_peek (char const *variable);
+
 /* Mimic b4_percent_define_ifdef in ../data/bison.m4 exactly.  That is, if the
    %define variable VARIABLE is defined, return true.  Otherwise, return false.
    Also, record Bison's usage of VARIABLE by defining
@@ -55,7 +55,7 @@ static struct obstack format_obstack;
 |                                                                    |
 | For the typical case of outputting a complete table from 0, pass   |
 | TABLE[0] as FIRST, and 1 as BEGIN.  For instance                   |
-| muscle_insert_base_table ("pact", base, base[0], 1, nstates);      |
+| muscle_insert_int_table ("r2", r2, r2[0], 1, nrules);              |
 `-------------------------------------------------------------------*/
 
 
@@ -98,11 +98,90 @@ Name (char const *name, Type *table_data, Type first,                   \
 }
 
 GENERATE_MUSCLE_INSERT_TABLE (muscle_insert_int_table, int)
-GENERATE_MUSCLE_INSERT_TABLE (muscle_insert_base_table, base_number)
-GENERATE_MUSCLE_INSERT_TABLE (muscle_insert_rule_number_table, rule_number)
 GENERATE_MUSCLE_INSERT_TABLE (muscle_insert_symbol_number_table, symbol_number)
 GENERATE_MUSCLE_INSERT_TABLE (muscle_insert_item_number_table, item_number)
-GENERATE_MUSCLE_INSERT_TABLE (muscle_insert_state_number_table, state_number)
+
+
+/*------------------------------------------------------------------.
+| The large parser tables (yypact, yytable, yycheck...) are not      |
+| formatted into muscles: M4 would only copy their digits verbatim.  |
+| Rather, the muscle NAME is bound to the '@table(NAME@)' directive,  |
+| which the skeleton scanner expands by calling output_table.  Only   |
+| NAME_min and NAME_max are given to M4, to select the integer type.  |
+`------------------------------------------------------------------*/
+
+typedef struct
+{
+  char const *name;
+  int const *data;
+  int first;
+  int begin;
+  int end;
+} streamed_table;
+
+static streamed_table *streamed_tables = NULL;
+static int streamed_tables_count = 0;
+
+static void
+muscle_insert_streamed_table (char const *name, int const *table_data,
+                              int first, int begin, int end)
+{
+  streamed_tables = xnrealloc (streamed_tables, streamed_tables_count + 1,
+                               sizeof *streamed_tables);
+  streamed_tables[streamed_tables_count++]
+    = (streamed_table) { name, table_data, first, begin, end };
+
+  int min = first;
+  int max = first;
+  for (int i = begin; i < end; ++i)
+    {
+      if (table_data[i] < min)
+        min = table_data[i];
+      if (max < table_data[i])
+        max = table_data[i];
+    }
+
+  obstack_printf (&format_obstack, "@table(%s@)", name);
+  muscle_insert (name, obstack_finish0 (&format_obstack));
+
+  long lmin = min;
+  long lmax = max;
+  obstack_printf (&format_obstack, "%s_min", name);
+  MUSCLE_INSERT_LONG_INT (obstack_finish0 (&format_obstack), lmin);
+  obstack_printf (&format_obstack, "%s_max", name);
+  MUSCLE_INSERT_LONG_INT (obstack_finish0 (&format_obstack), lmax);
+}
+
+
+/* Print the table NAME on OUT, formatted as GENERATE_MUSCLE_INSERT_TABLE
+   does, and add to *LINENO the number of lines output.  */
+
+void
+output_table (FILE *out, char const *name, int *lineno)
+{
+  for (int t = 0; t < streamed_tables_count; ++t)
+    if (STREQ (streamed_tables[t].name, name))
+      {
+        streamed_table const *tab = &streamed_tables[t];
+        int j = 1;
+        fprintf (out, "%6d", tab->first);
+        for (int i = tab->begin; i < tab->end; ++i)
+          {
+            putc (',', out);
+            if (j >= 10)
+              {
+                fputs ("\n  ", out);
+                ++*lineno;
+                j = 1;
+              }
+            else
+              ++j;
+            fprintf (out, "%6d", tab->data[i]);
+          }
+        return;
+      }
+  complain (NULL, fatal, _("invalid table in skeleton: %s"), name);
+}
 
 
 /*----------------------------------------------------------------.
@@ -675,35 +754,108 @@ prepare_symbol_definitions (void)
 }
 
 
+/* With %define parse.expected-tables, the tokens expected in state S
+   are EXPECTED_TOKENS[EXPECTED_INDEX[S] .. EXPECTED_INDEX[S+1] - 1].  */
+static int *expected_index = NULL;
+static int *expected_tokens = NULL;
+
+/* Whether token X has an explicit action in state S, i.e., whether it
+   is reported as expected in the syntax error messages.  Mimic
+   yypcontext_expected_tokens in yacc.c.  */
+static bool
+expected_token_p (state_number s, symbol_number x)
+{
+  int n = base[s];
+  return n != base_ninf
+    && 0 <= n + x && n + x <= high
+    && check[n + x] == x
+    && x != errtoken->content->number
+    && table[n + x] != table_ninf;
+}
+
+
+/*---------------------------------------------------------------.
+| Whether parse.expected-tables is set.  Peek at it: the         |
+| skeletons that output the tables record its usage themselves,  |
+| so that it is reported as unused otherwise.                    |
+`---------------------------------------------------------------*/
+
+static bool
+expected_tables_p (void)
+{
+  char *value = muscle_percent_define_peek ("parse.expected-tables");
+  bool res = value && (STREQ (value, "") || STREQ (value, "true"));
+  free (value);
+  return res;
+}
+
+
+/*------------------------------------------------------------------.
+| Prepare the tables of the expected tokens of each state, so that  |
+| the parsers do not have to scan YYCHECK to build syntax error     |
+| messages.                                                         |
+`------------------------------------------------------------------*/
+
+static void
+prepare_expected_tokens (void)
+{
+  expected_index = xnmalloc (nstates + 1, sizeof *expected_index);
+  int count = 0;
+  for (state_number s = 0; s < nstates; ++s)
+    {
+      expected_index[s] = count;
+      for (symbol_number x = 0; x < ntokens; ++x)
+        count += expected_token_p (s, x);
+    }
+  expected_index[nstates] = count;
+
+  /* Avoid a zero-size array in the skeletons.  */
+  expected_tokens = xnmalloc (count + 1, sizeof *expected_tokens);
+  expected_tokens[count] = 0;
+  for (state_number s = 0; s < nstates; ++s)
+    {
+      int *p = expected_tokens + expected_index[s];
+      for (symbol_number x = 0; x < ntokens; ++x)
+        if (expected_token_p (s, x))
+          *p++ = x;
+    }
+
+  muscle_insert_streamed_table ("expected_index", expected_index,
+                                expected_index[0], 1, nstates + 1);
+  muscle_insert_streamed_table ("expected_tokens", expected_tokens,
+                                expected_tokens[0], 1, count + 1);
+}
+
+
 static void
 prepare_actions (void)
 {
   /* Figure out the actions for the specified state.  */
-  muscle_insert_rule_number_table ("defact", yydefact,
-                                   yydefact[0], 1, nstates);
+  muscle_insert_streamed_table ("defact", yydefact,
+                                yydefact[0], 1, nstates);
 
   /* Figure out what to do after reducing with each rule, depending on
      the saved state from before the beginning of parsing the data
      that matched this rule.  */
-  muscle_insert_state_number_table ("defgoto", yydefgoto,
-                                    yydefgoto[0], 1, nsyms - ntokens);
+  muscle_insert_streamed_table ("defgoto", yydefgoto,
+                                yydefgoto[0], 1, nsyms - ntokens);
 
 
   /* Output PACT. */
-  muscle_insert_base_table ("pact", base,
-                             base[0], 1, nstates);
+  muscle_insert_streamed_table ("pact", base,
+                                base[0], 1, nstates);
   MUSCLE_INSERT_INT ("pact_ninf", base_ninf);
 
   /* Output PGOTO. */
-  muscle_insert_base_table ("pgoto", base,
-                             base[nstates], nstates + 1, nvectors);
+  muscle_insert_streamed_table ("pgoto", base,
+                                base[nstates], nstates + 1, nvectors);
 
-  muscle_insert_base_table ("table", table,
-                            table[0], 1, high + 1);
+  muscle_insert_streamed_table ("table", table,
+                                table[0], 1, high + 1);
   MUSCLE_INSERT_INT ("table_ninf", table_ninf);
 
-  muscle_insert_base_table ("check", check,
-                            check[0], 1, high + 1);
+  muscle_insert_streamed_table ("check", check,
+                                check[0], 1, high + 1);
 
   /* GLR parsing slightly modifies YYTABLE and YYCHECK (and thus
      YYPACT) so that in states with unresolved conflicts, the default
@@ -714,10 +866,13 @@ prepare_actions (void)
      parser, so we could avoid accidents by not writing them out in
      that case.  Nevertheless, it seems even better to be able to use
      the GLR skeletons even without the non-deterministic tables.  */
-  muscle_insert_int_table ("conflict_list_heads", conflict_table,
-                           conflict_table[0], 1, high + 1);
-  muscle_insert_int_table ("conflicting_rules", conflict_list,
-                           0, 1, conflict_list_cnt);
+  muscle_insert_streamed_table ("conflict_list_heads", conflict_table,
+                                conflict_table[0], 1, high + 1);
+  muscle_insert_streamed_table ("conflicting_rules", conflict_list,
+                                0, 1, conflict_list_cnt);
+
+  if (expected_tables_p ())
+    prepare_expected_tokens ();
 }
 
 
@@ -932,5 +1087,10 @@ output (void)
   if (complaint_status)
     unlink_generated_sources ();
 
+  free (expected_tokens);
+  free (expected_index);
+  free (streamed_tables);
+  streamed_tables = NULL;
+  streamed_tables_count = 0;
   obstack_free (&format_obstack, NULL);
 }
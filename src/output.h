@@ -21,7 +21,13 @@
 #ifndef OUTPUT_H_
 # define OUTPUT_H_
 
+# include <stdio.h>
+
 /* Output the parsing tables and the parser code to FTABLE.  */
 void output (void);
 
+/* Print on OUT the parser table NAME, as requested by the skeleton's
+   '@table(NAME@)' directive.  Increment *LINENO for each line output.  */
+void output_table (FILE *out, char const *name, int *lineno);
+
 #endif /* !OUTPUT_H_ */
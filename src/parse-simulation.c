@@ -33,7 +33,9 @@ struct parse_state
   // Path of state-items the parser has traversed.
   struct si_chunk
   {
-    // Elements newly added in this chunk.
+    // Elements newly added in this chunk.  Most chunks of copied parse
+    // states hold one element or none, so the list is allocated when the
+    // first element is added: NULL stands for an empty chunk.
     state_item_list contents;
     // Properties of the linked list this chunk represents.
     const state_item *head_elt;
@@ -43,6 +45,7 @@ struct parse_state
   // List of derivations of the symbols.
   struct deriv_chunk
   {
+    // Likewise, NULL for an empty chunk.
     derivation_list contents;
     const derivation *head_elt;
     const derivation *tail_elt;
@@ -65,6 +68,9 @@ static void
 ps_si_prepend (parse_state *ps, const state_item *si)
 {
   struct si_chunk *sic = &ps->state_items;
+  if (!sic->contents)
+    sic->contents
+      = gl_list_create_empty (GL_LINKED_LIST, NULL, NULL, NULL, true);
   gl_list_add_first (sic->contents, si);
   sic->head_elt = si;
   ++sic->total_size;
@@ -76,6 +82,9 @@ static void
 ps_si_append (parse_state *ps, const state_item *si)
 {
   struct si_chunk *sic = &ps->state_items;
+  if (!sic->contents)
+    sic->contents
+      = gl_list_create_empty (GL_LINKED_LIST, NULL, NULL, NULL, true);
   gl_list_add_last (sic->contents, si);
   sic->tail_elt = si;
   ++sic->total_size;
@@ -87,6 +96,8 @@ static void
 ps_derivs_prepend (parse_state *ps, derivation *d)
 {
   struct deriv_chunk *dc = &ps->derivs;
+  if (!dc->contents)
+    dc->contents = derivation_list_new ();
   derivation_list_prepend (dc->contents, d);
   dc->head_elt = d;
   ++dc->total_size;
@@ -98,6 +109,8 @@ static void
 ps_derivs_append (parse_state *ps, derivation *d)
 {
   struct deriv_chunk *dc = &ps->derivs;
+  if (!dc->contents)
+    dc->contents = derivation_list_new ();
   derivation_list_append (dc->contents, d);
   dc->tail_elt = d;
   ++dc->total_size;
@@ -133,9 +146,8 @@ copy_parse_state (bool prepend, parse_state *parent)
 {
   parse_state *res = xmalloc (sizeof *res);
   *res = *parent;
-  res->state_items.contents
-    = gl_list_create_empty (GL_LINKED_LIST, NULL, NULL, NULL, true);
-  res->derivs.contents = derivation_list_new ();
+  res->state_items.contents = NULL;
+  res->derivs.contents = NULL;
   res->parent = parent;
   res->prepend = prepend;
   res->reference_count = 0;
@@ -336,13 +348,17 @@ parser_pop (parse_state *ps, int deriv_index,
   for (parse_state *pn = ps; pn != NULL; pn = pn->parent)
     if (pn->prepend)
       {
-        gl_list_add_last (chunks[0], pn->state_items.contents);
-        gl_list_add_last (chunks[2], pn->derivs.contents);
+        if (pn->state_items.contents)
+          gl_list_add_last (chunks[0], pn->state_items.contents);
+        if (pn->derivs.contents)
+          gl_list_add_last (chunks[2], pn->derivs.contents);
       }
     else
       {
-        gl_list_add_first (chunks[1], pn->state_items.contents);
-        gl_list_add_first (chunks[3], pn->derivs.contents);
+        if (pn->state_items.contents)
+          gl_list_add_first (chunks[1], pn->state_items.contents);
+        if (pn->derivs.contents)
+          gl_list_add_first (chunks[3], pn->derivs.contents);
       }
   derivation_list popped_derivs = derivation_list_new ();
   gl_list_t ret_chunks[4] = { ret->state_items.contents, NULL,
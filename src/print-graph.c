@@ -23,6 +23,9 @@
 
 #include "system.h"
 
+#include <errno.h>
+#include <quote.h>
+
 #include "closure.h"
 #include "complain.h"
 #include "conflicts.h"
@@ -32,10 +35,14 @@
 #include "graphviz.h"
 #include "lalr.h"
 #include "lr0.h"
+#include "muscle-tab.h"
 #include "reader.h"
 #include "state.h"
 #include "symtab.h"
 
+/* Whether each state is to be output (see graph.radius).  */
+static bool *state_selected;
+
 
 /*----------------------------.
 | Construct the node labels.  |
@@ -138,7 +145,8 @@ print_actions (state const *s, FILE *fgraph)
     return;
 
   for (int i = 0; i < trans->num; i++)
-    if (!TRANSITION_IS_DISABLED (trans, i))
+    if (!TRANSITION_IS_DISABLED (trans, i)
+        && state_selected[trans->states[i]->number])
       {
         const state *s1 = trans->states[i];
         const symbol_number sym = s1->accessing_symbol;
@@ -182,15 +190,126 @@ print_state (state *s, FILE *fgraph)
 }
 
 
+/*-------------------------------------------------------------.
+| Return the value of the integral %define VARIABLE, or -1 if  |
+| it is not defined or invalid.                                |
+`-------------------------------------------------------------*/
+
+static long
+graph_define_get (char const *variable)
+{
+  long res = -1;
+  char *cp = muscle_percent_define_get (variable);
+  if (*cp != '\0')
+    {
+      char *end = NULL;
+      errno = 0;
+      long v = strtol (cp, &end, 10);
+      if (*end == '\0' && errno == 0 && v >= 0)
+        res = v;
+      else
+        {
+          location loc = muscle_percent_define_get_loc (variable);
+          complain (&loc, complaint,
+                    _("invalid value for %%define variable %s: %s"),
+                    quote (variable), quote_n (1, cp));
+        }
+    }
+  free (cp);
+  return res;
+}
+
+
+/*-----------------------------------------------------------------.
+| Set STATE_SELECTED.  If neither graph.radius nor graph.states is |
+| defined, all the states are selected.  Otherwise select only the |
+| states at a distance of at most graph.radius transitions, in     |
+| either direction, from the states listed in graph.states, or     |
+| from the states with conflicts if graph.states is not defined.   |
+| graph.radius defaults to 0: only the listed states.              |
+`-----------------------------------------------------------------*/
+
+static void
+state_selected_init (void)
+{
+  state_selected = xnmalloc (nstates, sizeof *state_selected);
+  long radius = graph_define_get ("graph.radius");
+
+  char const *variable = "graph.states";
+  char *cp = muscle_percent_define_get (variable);
+  if (radius < 0 && *cp == '\0')
+    {
+      for (state_number i = 0; i < nstates; ++i)
+        state_selected[i] = true;
+      free (cp);
+      return;
+    }
+  if (radius < 0)
+    radius = 0;
+
+  /* Distance from the selected states, -1 if beyond the radius.  */
+  int *dist = xnmalloc (nstates, sizeof *dist);
+  for (state_number i = 0; i < nstates; ++i)
+    dist[i] = -1;
+
+  if (*cp != '\0')
+    for (char *p = cp; *p; )
+      {
+        char *end = NULL;
+        errno = 0;
+        long v = strtol (p, &end, 10);
+        if (end == p || errno || v < 0 || nstates <= v)
+          {
+            location loc = muscle_percent_define_get_loc (variable);
+            complain (&loc, complaint,
+                      _("invalid value for %%define variable %s: %s"),
+                      quote (variable), quote_n (1, cp));
+            break;
+          }
+        dist[v] = 0;
+        p = end + strspn (end, ", \t");
+      }
+  else
+    for (state_number i = 0; i < nstates; ++i)
+      if (has_conflicts (states[i]))
+        dist[i] = 0;
+  free (cp);
+
+  for (int d = 0; d < radius; ++d)
+    for (state_number i = 0; i < nstates; ++i)
+      {
+        transitions const *trans = states[i]->transitions;
+        for (int j = 0; j < trans->num; j++)
+          if (!TRANSITION_IS_DISABLED (trans, j))
+            {
+              state_number dst = trans->states[j]->number;
+              if (dist[i] == d && dist[dst] < 0)
+                dist[dst] = d + 1;
+              else if (dist[dst] == d && dist[i] < 0)
+                dist[i] = d + 1;
+            }
+      }
+
+  for (state_number i = 0; i < nstates; ++i)
+    state_selected[i] = 0 <= dist[i];
+  free (dist);
+}
+
+
 void
 print_graph (void)
 {
   FILE *fgraph = xfopen (spec_graph_file, "w");
   start_graph (fgraph);
 
+  state_selected_init ();
+
   /* Output nodes and edges. */
   for (int i = 0; i < nstates; i++)
-    print_state (states[i], fgraph);
+    if (state_selected[i])
+      print_state (states[i], fgraph);
+
+  free (state_selected);
 
   finish_graph (fgraph);
   xfclose (fgraph);
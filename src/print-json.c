@@ -0,0 +1,292 @@
+/* Print a JSON Lines report on generated parser, for Bison,
+
+   Copyright (C) 2022 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+#include "print-json.h"
+
+#include "system.h"
+
+#include <bitset.h>
+
+#include "closure.h"
+#include "files.h"
+#include "getargs.h"
+#include "gram.h"
+#include "lalr.h"
+#include "lr0.h"
+#include "print.h"
+#include "reader.h"
+#include "state.h"
+#include "symtab.h"
+#include "tables.h"
+
+/* For a given state, the symbol numbers of the lookahead tokens for
+   shifts and errors (i.e. not reduce).  */
+static bitset no_reduce_set;
+
+/* For a given state, the union of the lookahead sets of its
+   reductions.  */
+static bitset lookahead_set;
+
+
+/*--------------------------------------------.
+| Print STR on OUT as a JSON string literal.  |
+`--------------------------------------------*/
+
+static void
+json_string (FILE *out, char const *str)
+{
+  putc ('"', out);
+  for (char const *p = str; *p; ++p)
+    switch (*p)
+      {
+      case '"':  fputs ("\\\"", out); break;
+      case '\\': fputs ("\\\\", out); break;
+      case '\n': fputs ("\\n", out);  break;
+      case '\t': fputs ("\\t", out);  break;
+      default:
+        if ((unsigned char) *p < 0x20)
+          fprintf (out, "\\u%04x", (unsigned char) *p);
+        else
+          putc (*p, out);
+        break;
+      }
+  putc ('"', out);
+}
+
+
+/*----------------------------------------------------------------.
+| Print the items of S, including the closure, with the lookahead |
+| tokens of the reductions.                                       |
+`----------------------------------------------------------------*/
+
+static void
+print_core (FILE *out, state *s)
+{
+  closure (s->items, s->nitems);
+
+  fputs (",\"itemset\":[", out);
+  for (size_t i = 0; i < nitemset; i++)
+    {
+      item_number *sp1 = ritem + itemset[i];
+      rule const *r = item_rule (sp1);
+      fprintf (out, "%s{\"rule\":%d,\"dot\":%d",
+               i ? "," : "", r->number, (int) (sp1 - r->rhs));
+
+      if (item_number_is_rule_number (*sp1))
+        {
+          reductions *reds = s->reductions;
+          int red = state_reduction_find (s, r);
+          if (reds->lookaheads && red != -1)
+            {
+              fputs (",\"lookaheads\":[", out);
+              bool first = true;
+              bitset_iterator biter;
+              int k;
+              BITSET_FOR_EACH (biter, reds->lookaheads[red], k, 0)
+                {
+                  if (!first)
+                    putc (',', out);
+                  json_string (out, symbols[k]->tag);
+                  first = false;
+                }
+              putc (']', out);
+            }
+        }
+      putc ('}', out);
+    }
+  putc (']', out);
+}
+
+
+/*-----------------------------------------.
+| Print the shifts, then the gotos, of S.  |
+`-----------------------------------------*/
+
+static void
+print_transitions (FILE *out, state *s)
+{
+  transitions *trans = s->transitions;
+  bool first = true;
+
+  fputs (",\"transitions\":[", out);
+  for (int shift = 1; 0 <= shift; --shift)
+    for (int i = 0; i < trans->num; i++)
+      if (!TRANSITION_IS_DISABLED (trans, i)
+          && TRANSITION_IS_SHIFT (trans, i) == shift)
+        {
+          fprintf (out, "%s{\"type\":\"%s\",\"symbol\":",
+                   first ? "" : ",", shift ? "shift" : "goto");
+          json_string (out, symbols[TRANSITION_SYMBOL (trans, i)]->tag);
+          fprintf (out, ",\"state\":%d}", trans->states[i]->number);
+          first = false;
+        }
+  putc (']', out);
+}
+
+
+/*-------------------------------------------------------.
+| Print the explicit errors of S raised from %nonassoc.  |
+`-------------------------------------------------------*/
+
+static void
+print_errs (FILE *out, state *s)
+{
+  errs *errp = s->errs;
+  bool first = true;
+
+  fputs (",\"errors\":[", out);
+  for (int i = 0; i < errp->num; ++i)
+    if (errp->symbols[i])
+      {
+        if (!first)
+          putc (',', out);
+        json_string (out, errp->symbols[i]->tag);
+        first = false;
+      }
+  putc (']', out);
+}
+
+
+/* The state of print_reduction.  */
+typedef struct
+{
+  FILE *out;
+  /* Whether no reduction was printed yet.  */
+  bool first;
+} reduction_printer;
+
+
+/*-------------------------------------------------------------------.
+| Print a reduction of RULE on LOOKAHEAD (which can be '$default').  |
+| If not ENABLED, the rule is masked by a shift or a reduce (S/R and |
+| R/R conflicts).                                                    |
+`-------------------------------------------------------------------*/
+
+static void
+print_reduction (symbol const *lookahead, rule *r, bool enabled,
+                 void *data)
+{
+  reduction_printer *p = data;
+  FILE *out = p->out;
+  fputs (p->first ? "{\"symbol\":" : ",{\"symbol\":", out);
+  json_string (out, lookahead ? lookahead->tag : "$default");
+  if (rule_is_initial (r))
+    fputs (",\"rule\":\"accept\"", out);
+  else
+    fprintf (out, ",\"rule\":%d", r->number);
+  fprintf (out, ",\"enabled\":%s}", enabled ? "true" : "false");
+  p->first = false;
+}
+
+
+/*--------------------------------------------------.
+| Print the reductions of S, as in the XML report.  |
+`--------------------------------------------------*/
+
+static void
+print_reductions (FILE *out, state *s)
+{
+  fputs (",\"reductions\":[", out);
+  reduction_printer printer = { out, true };
+  state_reductions_map (s, no_reduce_set, lookahead_set,
+                        print_reduction, &printer);
+  putc (']', out);
+}
+
+
+/*-----------------------------------.
+| Print S on OUT, on a single line.  |
+`-----------------------------------*/
+
+static void
+print_state (FILE *out, state *s)
+{
+  fprintf (out, "{\"state\":%d", s->number);
+  print_core (out, s);
+  print_transitions (out, s);
+  print_errs (out, s);
+  print_reductions (out, s);
+  fputs ("}\n", out);
+}
+
+
+/*--------------------------------.
+| Print rule R on a single line.  |
+`--------------------------------*/
+
+static void
+print_rule (FILE *out, rule const *r)
+{
+  fprintf (out, "{\"rule\":%d,\"lhs\":", r->number);
+  json_string (out, r->lhs->symbol->tag);
+  fputs (",\"rhs\":[", out);
+  for (item_number *rhsp = r->rhs; 0 <= *rhsp; ++rhsp)
+    {
+      if (rhsp != r->rhs)
+        putc (',', out);
+      json_string (out, symbols[*rhsp]->tag);
+    }
+  fputs ("]}\n", out);
+}
+
+
+void
+print_json (void)
+{
+  FILE *out = xfopen (spec_json_file, "w");
+
+  fputs ("{\"bison-json-report\":", out);
+  json_string (out, VERSION);
+  fputs (",\"filename\":", out);
+  json_string (out, grammar_file);
+  fprintf (out, ",\"rules\":%d,\"states\":%d}\n", nrules, nstates);
+
+  for (rule_number r = 0; r < nrules; ++r)
+    print_rule (out, &rules[r]);
+
+  /* Byte offset of each state line, so that readers can seek.  There
+     is no index if the output is not seekable (e.g., a pipe).  */
+  long *offsets = xnmalloc (nstates, sizeof *offsets);
+  bool seekable = true;
+  no_reduce_set = bitset_create (ntokens, BITSET_FIXED);
+  lookahead_set = bitset_create (ntokens, BITSET_FIXED);
+  for (state_number i = 0; i < nstates; i++)
+    {
+      if (seekable)
+        {
+          offsets[i] = ftell (out);
+          seekable = 0 <= offsets[i];
+        }
+      print_state (out, states[i]);
+    }
+  bitset_free (lookahead_set);
+  bitset_free (no_reduce_set);
+
+  if (seekable)
+    {
+      fputs ("{\"index\":[", out);
+      for (state_number i = 0; i < nstates; i++)
+        fprintf (out, "%s%ld", i ? "," : "", offsets[i]);
+      fputs ("]}\n", out);
+    }
+  free (offsets);
+
+  xfclose (out);
+}
@@ -0,0 +1,28 @@
+/* Print a JSON Lines report on generated parser, for Bison,
+
+   Copyright (C) 2022 Free Software Foundation, Inc.
+
+   This file is part of Bison, the GNU Compiler Compiler.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#ifndef PRINT_JSON_H_
+# define PRINT_JSON_H_
+
+/* Output the automaton in spec_json_file: one JSON object per line,
+   for the grammar, each rule, and each state, followed by an index
+   of the byte offsets of the states.  */
+void print_json (void);
+
+#endif /* !PRINT_JSON_H_ */
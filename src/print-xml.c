@@ -45,6 +45,10 @@
 #include "tables.h"
 
 static bitset no_reduce_set;
+
+/* For a given state, the union of the lookahead sets of its
+   reductions.  */
+static bitset lookahead_set;
 struct escape_buf
 {
   char *ptr;
@@ -206,6 +210,14 @@ print_errs (FILE *out, int level, state *s)
 }
 
 
+/* The state of print_reduction.  */
+typedef struct
+{
+  FILE *out;
+  int level;
+} reduction_printer;
+
+
 /*-------------------------------------------------------------------.
 | Report a reduction of RULE on LOOKAHEAD (which can be 'default').  |
 | If not ENABLED, the rule is masked by a shift or a reduce (S/R and |
@@ -213,23 +225,41 @@ print_errs (FILE *out, int level, state *s)
 `-------------------------------------------------------------------*/
 
 static void
-print_reduction (FILE *out, int level, char const *lookahead,
-                 rule *r, bool enabled)
+print_reduction (symbol const *lookahead, rule *r, bool enabled,
+                 void *data)
 {
+  reduction_printer const *p = data;
+  char const *tag = lookahead ? lookahead->tag : "$default";
   if (rule_is_initial (r))
-    xml_printf (out, level,
+    xml_printf (p->out, p->level,
                 "<reduction symbol=\"%s\" rule=\"accept\" enabled=\"%s\"/>",
-                xml_escape (lookahead),
+                xml_escape (tag),
                 enabled ? "true" : "false");
   else
-    xml_printf (out, level,
+    xml_printf (p->out, p->level,
                 "<reduction symbol=\"%s\" rule=\"%d\" enabled=\"%s\"/>",
-                xml_escape (lookahead),
+                xml_escape (tag),
                 r->number,
                 enabled ? "true" : "false");
 }
 
 
+/*--------------------------------------------.
+| Record in *DATA that there is a reduction.  |
+`--------------------------------------------*/
+
+static void
+reduction_count (symbol const *lookahead, rule *r, bool enabled,
+                 void *data)
+{
+  (void) lookahead;
+  (void) r;
+  (void) enabled;
+  bool *report = data;
+  *report = true;
+}
+
+
 /*-------------------------------------------.
 | Report on OUT the reduction actions of S.  |
 `-------------------------------------------*/
@@ -237,51 +267,9 @@ print_reduction (FILE *out, int level, char const *lookahead,
 static void
 print_reductions (FILE *out, int level, state *s)
 {
-  transitions *trans = s->transitions;
-  reductions *reds = s->reductions;
-  rule *default_reduction = NULL;
-  int report = false;
-  int i, j;
-
-  if (reds->num == 0)
-    {
-      xml_puts (out, level, "<reductions/>");
-      return;
-    }
-
-  if (yydefact[s->number] != 0)
-    default_reduction = &rules[yydefact[s->number] - 1];
-
-  bitset_zero (no_reduce_set);
-  FOR_EACH_SHIFT (trans, i)
-    bitset_set (no_reduce_set, TRANSITION_SYMBOL (trans, i));
-  for (i = 0; i < s->errs->num; ++i)
-    if (s->errs->symbols[i])
-      bitset_set (no_reduce_set, s->errs->symbols[i]->content->number);
-
-  if (default_reduction)
-    report = true;
-
-  if (reds->lookaheads)
-    for (i = 0; i < ntokens; i++)
-      {
-        bool count = bitset_test (no_reduce_set, i);
-
-        for (j = 0; j < reds->num; ++j)
-          if (bitset_test (reds->lookaheads[j], i))
-            {
-              if (! count)
-                {
-                  if (reds->rules[j] != default_reduction)
-                    report = true;
-                  count = true;
-                }
-              else
-                {
-                  report = true;
-                }
-            }
-      }
+  bool report = false;
+  state_reductions_map (s, no_reduce_set, lookahead_set,
+                        reduction_count, &report);
 
   /* Nothing to report. */
   if (!report)
@@ -291,42 +279,9 @@ print_reductions (FILE *out, int level, state *s)
     }
 
   xml_puts (out, level, "<reductions>");
-
-  /* Report lookahead tokens (or $default) and reductions.  */
-  if (reds->lookaheads)
-    for (i = 0; i < ntokens; i++)
-      {
-        bool defaulted = false;
-        bool count = bitset_test (no_reduce_set, i);
-
-        for (j = 0; j < reds->num; ++j)
-          if (bitset_test (reds->lookaheads[j], i))
-            {
-              if (! count)
-                {
-                  if (reds->rules[j] != default_reduction)
-                    print_reduction (out, level + 1, symbols[i]->tag,
-                                     reds->rules[j], true);
-                  else
-                    defaulted = true;
-                  count = true;
-                }
-              else
-                {
-                  if (defaulted)
-                    print_reduction (out, level + 1, symbols[i]->tag,
-                                     default_reduction, true);
-                  defaulted = false;
-                  print_reduction (out, level + 1, symbols[i]->tag,
-                                   reds->rules[j], false);
-                }
-            }
-      }
-
-  if (default_reduction)
-    print_reduction (out, level + 1,
-                     "$default", default_reduction, true);
-
+  reduction_printer printer = { out, level + 1 };
+  state_reductions_map (s, no_reduce_set, lookahead_set,
+                        print_reduction, &printer);
   xml_puts (out, level, "</reductions>");
 }
 
@@ -518,6 +473,7 @@ print_xml (void)
   print_grammar (out, level + 1);
 
   no_reduce_set = bitset_create (ntokens, BITSET_FIXED);
+  lookahead_set = bitset_create (ntokens, BITSET_FIXED);
 
   /* print automaton */
   fputc ('\n', out);
@@ -526,6 +482,7 @@ print_xml (void)
     print_state (out, level + 2, states[i]);
   xml_puts (out, level + 1, "</automaton>");
 
+  bitset_free (lookahead_set);
   bitset_free (no_reduce_set);
 
   xml_puts (out, 0, "</bison-xml-report>");
@@ -47,6 +47,16 @@
    shifts and errors (i.e. not reduce).  */
 static bitset no_reduce_set;
 
+/* For a given state, the union of the lookahead sets of its
+   reductions.  */
+static bitset lookahead_set;
+
+/* The screen width of the tag of each token.  */
+static size_t *token_tag_width;
+
+/* The value of lr.default-reduction.  */
+static char *default_reductions;
+
 
 
 /*---------------------------------------.
@@ -182,6 +192,101 @@ print_errs (FILE *out, const state *s)
 }
 
 
+void
+state_reductions_map (state const *s,
+                      bitset no_reduce_set, bitset lookahead_set,
+                      reduction_fun fun, void *data)
+{
+  reductions *reds = s->reductions;
+  if (reds->num == 0)
+    return;
+
+  rule *default_reduction = NULL;
+  if (yydefact[s->number] != 0)
+    default_reduction = &rules[yydefact[s->number] - 1];
+
+  transitions *trans = s->transitions;
+
+  bitset_zero (no_reduce_set);
+  {
+    int i;
+    FOR_EACH_SHIFT (trans, i)
+      bitset_set (no_reduce_set, TRANSITION_SYMBOL (trans, i));
+  }
+  for (int i = 0; i < s->errs->num; ++i)
+    if (s->errs->symbols[i])
+      bitset_set (no_reduce_set, s->errs->symbols[i]->content->number);
+
+  /* Only the tokens in LOOKAHEAD_SET can be reported.  */
+  bitset_zero (lookahead_set);
+  if (reds->lookaheads)
+    for (int j = 0; j < reds->num; ++j)
+      bitset_or (lookahead_set, lookahead_set, reds->lookaheads[j]);
+
+  symbol_number i;
+  bitset_iterator iter;
+  BITSET_FOR_EACH (iter, lookahead_set, i, 0)
+    {
+      bool defaulted = false;
+      bool count = bitset_test (no_reduce_set, i);
+
+      for (int j = 0; j < reds->num; ++j)
+        if (bitset_test (reds->lookaheads[j], i))
+          {
+            if (! count)
+              {
+                if (reds->rules[j] != default_reduction)
+                  fun (symbols[i], reds->rules[j], true, data);
+                else
+                  defaulted = true;
+                count = true;
+              }
+            else
+              {
+                if (defaulted)
+                  fun (symbols[i], default_reduction, true, data);
+                defaulted = false;
+                fun (symbols[i], reds->rules[j], false, data);
+              }
+          }
+    }
+
+  if (default_reduction)
+    fun (NULL, default_reduction, true, data);
+}
+
+
+/*-----------------------------------------------------------.
+| Update the width of the lookahead token column to include |
+| LOOKAHEAD (or $default).                                   |
+`-----------------------------------------------------------*/
+
+static void
+reduction_width (symbol const *lookahead, rule *r, bool enabled,
+                 void *data)
+{
+  (void) r;
+  (void) enabled;
+  size_t *width = data;
+  size_t len = (lookahead
+                ? token_tag_width[lookahead->content->number]
+                : (size_t) mbswidth (_("$default"), 0));
+  if (*width < len)
+    *width = len;
+}
+
+
+/* The state of print_reduction.  */
+typedef struct
+{
+  FILE *out;
+  /* The width of the lookahead token column.  */
+  size_t width;
+  /* Whether there is no reduction but the default one.  */
+  bool default_reduction_only;
+} reduction_printer;
+
+
 /*-------------------------------------------------------------------.
 | Report a reduction of RULE on LOOKAHEAD (which can be 'default').  |
 | If not ENABLED, the rule is masked by a shift or a reduce (S/R and |
@@ -189,12 +294,16 @@ print_errs (FILE *out, const state *s)
 `-------------------------------------------------------------------*/
 
 static void
-print_reduction (FILE *out, size_t width,
-                 const char *lookahead,
-                 rule *r, bool enabled)
+print_reduction (symbol const *lookahead, rule *r, bool enabled,
+                 void *data)
 {
-  fprintf (out, "    %s", lookahead);
-  for (int j = width - mbswidth (lookahead, 0); j > 0; --j)
+  reduction_printer *p = data;
+  FILE *out = p->out;
+  const char *tag = lookahead ? lookahead->tag : _("$default");
+  if (lookahead)
+    p->default_reduction_only = false;
+  fprintf (out, "    %s", tag);
+  for (int j = p->width - mbswidth (tag, 0); j > 0; --j)
     fputc (' ', out);
   if (!enabled)
     fputc ('[', out);
@@ -216,111 +325,25 @@ print_reduction (FILE *out, size_t width,
 static void
 print_reductions (FILE *out, const state *s)
 {
-  reductions *reds = s->reductions;
-  if (reds->num == 0)
-    return;
-
-  rule *default_reduction = NULL;
-  if (yydefact[s->number] != 0)
-    default_reduction = &rules[yydefact[s->number] - 1];
-
-  transitions *trans = s->transitions;
-
-  bitset_zero (no_reduce_set);
-  {
-    int i;
-    FOR_EACH_SHIFT (trans, i)
-      bitset_set (no_reduce_set, TRANSITION_SYMBOL (trans, i));
-  }
-  for (int i = 0; i < s->errs->num; ++i)
-    if (s->errs->symbols[i])
-      bitset_set (no_reduce_set, s->errs->symbols[i]->content->number);
-
-  /* Compute the width of the lookahead token column.  */
   size_t width = 0;
-  if (default_reduction)
-    width = mbswidth (_("$default"), 0);
-
-  if (reds->lookaheads)
-    for (int i = 0; i < ntokens; i++)
-      {
-        bool count = bitset_test (no_reduce_set, i);
-
-        for (int j = 0; j < reds->num; ++j)
-          if (bitset_test (reds->lookaheads[j], i))
-            {
-              if (! count)
-                {
-                  if (reds->rules[j] != default_reduction)
-                    max_length (&width, symbols[i]->tag);
-                  count = true;
-                }
-              else
-                max_length (&width, symbols[i]->tag);
-            }
-      }
+  state_reductions_map (s, no_reduce_set, lookahead_set,
+                        reduction_width, &width);
 
   /* Nothing to report. */
   if (!width)
     return;
 
   fputc ('\n', out);
-  width += 2;
-
-  bool default_reduction_only = true;
+  reduction_printer printer = { out, width + 2, true };
+  state_reductions_map (s, no_reduce_set, lookahead_set,
+                        print_reduction, &printer);
 
-  /* Report lookahead tokens (or $default) and reductions.  */
-  if (reds->lookaheads)
-    for (int i = 0; i < ntokens; i++)
-      {
-        bool defaulted = false;
-        bool count = bitset_test (no_reduce_set, i);
-        if (count)
-          default_reduction_only = false;
-
-        for (int j = 0; j < reds->num; ++j)
-          if (bitset_test (reds->lookaheads[j], i))
-            {
-              if (! count)
-                {
-                  if (reds->rules[j] != default_reduction)
-                    {
-                      default_reduction_only = false;
-                      print_reduction (out, width,
-                                       symbols[i]->tag,
-                                       reds->rules[j], true);
-                    }
-                  else
-                    defaulted = true;
-                  count = true;
-                }
-              else
-                {
-                  default_reduction_only = false;
-                  if (defaulted)
-                    print_reduction (out, width,
-                                     symbols[i]->tag,
-                                     default_reduction, true);
-                  defaulted = false;
-                  print_reduction (out, width,
-                                   symbols[i]->tag,
-                                   reds->rules[j], false);
-                }
-            }
-      }
-
-  if (default_reduction)
-    {
-      char *default_reductions =
-        muscle_percent_define_get ("lr.default-reduction");
-      print_reduction (out, width, _("$default"), default_reduction, true);
-      aver (STREQ (default_reductions, "most")
-            || (STREQ (default_reductions, "consistent")
-                && default_reduction_only)
-            || (reds->num == 1 && rule_is_initial (reds->rules[0])));
-      (void) default_reduction_only;
-      free (default_reductions);
-    }
+  if (yydefact[s->number] != 0)
+    aver (STREQ (default_reductions, "most")
+          || (STREQ (default_reductions, "consistent")
+              && printer.default_reduction_only)
+          || (s->reductions->num == 1
+              && rule_is_initial (s->reductions->rules[0])));
 }
 
 
@@ -467,8 +490,16 @@ print_results (void)
 
   /* Storage for print_reductions.  */
   no_reduce_set = bitset_create (ntokens, BITSET_FIXED);
+  lookahead_set = bitset_create (ntokens, BITSET_FIXED);
+  token_tag_width = xnmalloc (ntokens, sizeof *token_tag_width);
+  for (symbol_number i = 0; i < ntokens; ++i)
+    token_tag_width[i] = mbswidth (symbols[i]->tag, 0);
+  default_reductions = muscle_percent_define_get ("lr.default-reduction");
   for (state_number i = 0; i < nstates; i++)
     print_state (out, states[i]);
+  free (default_reductions);
+  free (token_tag_width);
+  bitset_free (lookahead_set);
   bitset_free (no_reduce_set);
 
   xfclose (out);
@@ -21,6 +21,26 @@
 #ifndef PRINT_H_
 # define PRINT_H_
 
+# include <bitset.h>
+
+# include "gram.h"
+# include "state.h"
+# include "symtab.h"
+
+/* Called by state_reductions_map on the reduction by R on LOOKAHEAD,
+   or on the default reduction if LOOKAHEAD is NULL.  If not ENABLED,
+   R is masked by a shift or a reduce (S/R and R/R conflicts).  */
+typedef void (*reduction_fun) (symbol const *lookahead, rule *r,
+                               bool enabled, void *data);
+
+/* Call FUN on each reduction of S to report, in the order of the
+   reports: first those on the lookahead tokens, then the default
+   reduction.  NO_REDUCE_SET and LOOKAHEAD_SET are storage for NTOKENS
+   bits.  */
+void state_reductions_map (state const *s,
+                           bitset no_reduce_set, bitset lookahead_set,
+                           reduction_fun fun, void *data);
+
 void print_results (void);
 
 #endif /* !PRINT_H_ */
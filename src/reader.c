@@ -777,6 +777,7 @@ prepare_percent_define_front_end_variables (void)
 {
   /* Set %define front-end variable defaults.  */
   muscle_percent_define_default ("lr.keep-unreachable-state", "false");
+  muscle_percent_define_default ("lr.unit-rule-elimination", "false");
   {
     /* IELR would be a better default, but LALR is historically the
        default.  */
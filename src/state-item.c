@@ -21,7 +21,6 @@
 
 #include "state-item.h"
 
-#include <assert.h>
 #include <gethrxtime.h>
 #include <gl_linked_list.h>
 #include <gl_xlist.h>
@@ -36,63 +35,6 @@ size_t nstate_items;
 state_item_number *state_item_map;
 state_item *state_items;
 
-// Hash functions for index -> bitset hash maps.
-typedef struct
-{
-  int key;
-  bitset l;
-} hash_pair;
-
-static size_t
-hash_pair_hasher (const hash_pair *sl, size_t max)
-{
-  return sl->key % max;
-}
-
-static bool
-hash_pair_comparator (const hash_pair *l, const hash_pair *r)
-{
-  return l->key == r->key;
-}
-
-static void
-hash_pair_free (hash_pair *hp)
-{
-  bitset_free (hp->l);
-  free (hp);
-}
-
-static Hash_table *
-hash_pair_table_create (int size)
-{
-  return hash_xinitialize (size,
-                           NULL,
-                           (Hash_hasher) hash_pair_hasher,
-                           (Hash_comparator) hash_pair_comparator,
-                           (Hash_data_freer) hash_pair_free);
-}
-
-static bitset
-hash_pair_lookup (Hash_table *tab, int key)
-{
-  hash_pair probe;
-  probe.key = key;
-  hash_pair *hp = hash_lookup (tab, &probe);
-  return hp ? hp->l : NULL;
-}
-
-static void
-hash_pair_insert (Hash_table *tab, int key, bitset val)
-{
-  hash_pair *hp = xmalloc (sizeof *hp);
-  hp->key = key;
-  hp->l = val;
-  hash_pair *res = hash_xinsert (tab, hp);
-  // This must be the first insertion.
-  (void) res;
-  assert (res == hp);
-}
-
 /* A state_item from a state's id and the offset of the item within
    the state. */
 state_item *
@@ -177,47 +119,25 @@ init_state_items (void)
   bitsetv_free (production_items);
 }
 
-static size_t
-state_sym_hasher (const void *st, size_t max)
-{
-  return ((state *) st)->accessing_symbol % max;
-}
-
-static bool
-state_sym_comparator (const void *s1, const void *s2)
-{
-  return ((state *) s1)->accessing_symbol == ((state *) s2)->accessing_symbol;
-}
-
-static state *
-state_sym_lookup (symbol_number sym, Hash_table *h)
-{
-  state probe;
-  probe.accessing_symbol = sym;
-  return hash_lookup (h, &probe);
-}
-
 static void
 init_trans (void)
 {
+  // Map from accessing symbols to the states the current state
+  // transitions to.  Reset after each state.
+  state **dsts = xcalloc (nsyms, sizeof *dsts);
   for (state_number i = 0; i < nstates; ++i)
     {
-      // Generate a hash set that maps from accepting symbols to the states
-      // this state transitions to.
       state *s = states[i];
       transitions *t = s->transitions;
-      Hash_table *transition_set
-        = hash_xinitialize (t->num, NULL, (Hash_hasher) state_sym_hasher,
-                            (Hash_comparator) state_sym_comparator, NULL);
       for (int j = 0; j < t->num; ++j)
         if (!TRANSITION_IS_DISABLED (t, j))
-          hash_xinsert (transition_set, t->states[j]);
+          dsts[TRANSITION_SYMBOL (t, j)] = t->states[j];
       for (state_item_number j = state_item_map[i]; j < state_item_map[i + 1]; ++j)
         {
           item_number *item = state_items[j].item;
           if (item_number_is_rule_number (*item))
             continue;
-          state *dst = state_sym_lookup (*item, transition_set);
+          state *dst = dsts[item_number_as_symbol_number (*item)];
           if (!dst)
             continue;
           // find the item in the destination state that corresponds
@@ -233,19 +153,23 @@ init_trans (void)
                 break;
             }
         }
-      hash_free (transition_set);
+      for (int j = 0; j < t->num; ++j)
+        if (!TRANSITION_IS_DISABLED (t, j))
+          dsts[TRANSITION_SYMBOL (t, j)] = NULL;
     }
+  free (dsts);
 }
 
 static void
 init_prods (void)
 {
+  // closure_map maps nonterminals to the set of the items of the
+  // current state that produce those nonterminals.  Reset after each
+  // state.
+  bitset *closure_map = xcalloc (nnterms, sizeof *closure_map);
   for (int i = 0; i < nstates; ++i)
     {
       state *s = states[i];
-      // closure_map is a hash map from nonterminals to a set
-      // of the items that produce those nonterminals
-      Hash_table *closure_map = hash_pair_table_create (nsyms - ntokens);
 
       // Add the nitems of state to skip to the production portion
       // of that state's state_items
@@ -255,13 +179,10 @@ init_prods (void)
           state_item *src = &state_items[j];
           item_number *item = src->item;
           symbol_number lhs = item_rule (item)->lhs->number;
-          bitset itms = hash_pair_lookup (closure_map, lhs);
-          if (!itms)
-            {
-              itms = bitset_create (nstate_items, BITSET_SPARSE);
-              hash_pair_insert (closure_map, lhs, itms);
-            }
-          bitset_set (itms, j);
+          bitset *itms = &closure_map[lhs - ntokens];
+          if (!*itms)
+            *itms = bitset_create (nstate_items, BITSET_SPARSE);
+          bitset_set (*itms, j);
         }
       // For each item with a dot followed by a nonterminal,
       // try to create a production edge.
@@ -273,7 +194,7 @@ init_prods (void)
           if (item_number_is_rule_number (item) || ISTOKEN (item))
             continue;
           symbol_number sym = item_number_as_symbol_number (item);
-          bitset lb = hash_pair_lookup (closure_map, sym);
+          bitset lb = closure_map[sym - ntokens];
           if (lb)
             {
               bitset copy = bitset_create (nstate_items, BITSET_SPARSE);
@@ -288,8 +209,18 @@ init_prods (void)
                 bitset_set (state_items[prod].revs, j);
             }
         }
-      hash_free (closure_map);
+      for (state_item_number j = state_item_map[i] + s->nitems;
+           j < state_item_map[i + 1]; ++j)
+        {
+          symbol_number lhs = item_rule (state_items[j].item)->lhs->number;
+          if (closure_map[lhs - ntokens])
+            {
+              bitset_free (closure_map[lhs - ntokens]);
+              closure_map[lhs - ntokens] = NULL;
+            }
+        }
     }
+  free (closure_map);
 }
 
 /* Since lookaheads are only generated for reductions, we need to
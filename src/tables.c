@@ -23,6 +23,7 @@
 
 #include <bitset.h>
 #include <bitsetv.h>
+#include <quote.h>
 
 #include "complain.h"
 #include "conflicts.h"
@@ -88,6 +89,11 @@ static int **conflict_tos;
 static size_t *tally;
 static base_number *width;
 
+/* If %define tables.profile is set, HITS[VECTOR] is the number of
+   times VECTOR was used according to the profile: the visits of a
+   state, or the reductions to a nonterminal.  Otherwise NULL.  */
+static size_t *hits = NULL;
+
 
 /* For a given state, N = ACTROW[SYMBOL]:
 
@@ -532,6 +538,70 @@ token_actions (void)
 }
 
 
+/*-------------------------------------------------------------------.
+| If the only action of state S is a default reduction by a unit     |
+| rule 'A: B' (B being an nterm) that can be skipped, return this    |
+| rule, otherwise NULL.                                              |
+|                                                                    |
+| The rule can be skipped if it has no action (hence $$ = $1 and @$  |
+| = @1), and if A and B have the same semantic type, %destructor and |
+| %printer, so that the value of B can stand for the value of A.     |
+`-------------------------------------------------------------------*/
+
+static rule const *
+state_unit_rule (state_number s)
+{
+  state const *st = states[s];
+  if (st->transitions->num || st->reductions->num != 1)
+    return NULL;
+  for (int i = 0; i < st->errs->num; ++i)
+    if (st->errs->symbols[i])
+      return NULL;
+
+  rule const *r = st->reductions->rules[0];
+  if (yydefact[s] != r->number + 1
+      || rule_is_initial (r)
+      || !rule_useless_chain_p (r)
+      || r->is_predicate || r->dprec || r->merger
+      || ISTOKEN (item_number_as_symbol_number (r->rhs[0])))
+    return NULL;
+
+  symbol *lhs = r->lhs->symbol;
+  symbol *rhs = symbols[item_number_as_symbol_number (r->rhs[0])];
+  if (!UNIQSTR_EQ (lhs->content->type_name, rhs->content->type_name))
+    return NULL;
+  for (int k = 0; k < CODE_PROPS_SIZE; ++k)
+    if (symbol_code_props_get (lhs, k) != symbol_code_props_get (rhs, k))
+      return NULL;
+  return r;
+}
+
+
+/*----------------------------------------------------------------.
+| With lr.unit-rule-elimination, redirect the gotos to the states |
+| that only reduce a unit rule 'A: B' (see state_unit_rule) to    |
+| the goto on A from the same state, so that the parser does not  |
+| go through them.  Follow chains of such rules.                  |
+`----------------------------------------------------------------*/
+
+static void
+unit_rules_eliminate (void)
+{
+  if (!muscle_percent_define_flag_if ("lr.unit-rule-elimination"))
+    return;
+
+  for (goto_number i = 0; i < ngotos; ++i)
+    {
+      /* Bound the length of the chains, in case of cycles.  */
+      rule const *r;
+      for (state_number n = 0;
+           n < nstates && (r = state_unit_rule (to_state[i]));
+           ++n)
+        to_state[i] = to_state[map_goto (from_state[i], r->lhs->number)];
+    }
+}
+
+
 /*------------------------------------------------------------------.
 | Compute FROMS[VECTOR], TOS[VECTOR], TALLY[VECTOR], WIDTH[VECTOR], |
 | i.e., the information related to non defaulted GOTO on the nterm  |
@@ -640,9 +710,75 @@ goto_actions (void)
 }
 
 
+/*-------------------------------------------------------------------.
+| If %define tables.profile is set, read the hit counts of the states |
+| and rules from this file into HITS.  Each line is either 'state     |
+| NUMBER COUNT' or 'rule NUMBER COUNT', with the numbers of the       |
+| report.  Empty lines and lines starting with '#' are ignored.       |
+`-------------------------------------------------------------------*/
+
+static void
+profile_read (void)
+{
+  char const *variable = "tables.profile";
+  char *file = muscle_percent_define_get (variable);
+  if (*file)
+    {
+      FILE *in = xfopen (file, "r");
+      char *line = NULL;
+      size_t size = 0;
+      hits = xcalloc (nvectors, sizeof *hits);
+      for (int lineno = 1; getline (&line, &size, in) != -1; ++lineno)
+        {
+          line[strcspn (line, "\r\n")] = '\0';
+          if (line[0] == '#' || line[strspn (line, " \t")] == '\0')
+            continue;
+
+          char kind[6];
+          long num;
+          unsigned long count;
+          char extra;
+          int n = sscanf (line, "%5s %ld %lu %c", kind, &num, &count, &extra);
+          if (n == 3 && STREQ (kind, "state") && 0 <= num && num < nstates)
+            hits[num] += count;
+          else if (n == 3 && STREQ (kind, "rule") && 0 <= num && num < nrules)
+            hits[symbol_number_to_vector_number (rules[num].lhs->number)]
+              += count;
+          else
+            {
+              location loc;
+              boundary_set (&loc.start, uniqstr_new (file), lineno, -1, -1);
+              loc.end = loc.start;
+              complain (&loc, complaint, _("invalid profile entry: %s"),
+                        quote (line));
+            }
+        }
+      free (line);
+      xfclose (in);
+    }
+  free (file);
+}
+
+
+/* Whether vector I should be packed before vector J: the most used
+   first, then the widest, then the most populated.  */
+
+static bool
+vector_precedes (vector_number i, vector_number j)
+{
+  if (hits && hits[i] != hits[j])
+    return hits[i] > hits[j];
+  if (width[i] != width[j])
+    return width[i] > width[j];
+  return tally[i] > tally[j];
+}
+
+
 /*------------------------------------------------------------------.
 | Compute ORDER, a reordering of vectors, in order to decide how to |
-| pack the actions and gotos information into yytable.              |
+| pack the actions and gotos information into yytable.  With a      |
+| profile, the hottest vectors are packed first, hence together at  |
+| the beginning of yytable and yycheck.                             |
 `------------------------------------------------------------------*/
 
 static void
@@ -653,14 +789,9 @@ sort_actions (void)
   for (int i = 0; i < nvectors; i++)
     if (0 < tally[i])
       {
-        const size_t t = tally[i];
-        const int w = width[i];
         int j = nentries - 1;
 
-        while (0 <= j && width[order[j]] < w)
-          j--;
-
-        while (0 <= j && width[order[j]] == w && tally[order[j]] < t)
+        while (0 <= j && vector_precedes (i, order[j]))
           j--;
 
         for (int k = nentries - 1; k > j; k--)
@@ -698,9 +829,13 @@ matching_state (vector_number vector)
         {
           vector_number j = order[prev];
           /* Given how ORDER was computed, if the WIDTH or TALLY is
-             different, there cannot be a matching state.  */
+             different, there cannot be a matching state, unless the
+             profile sorted the vectors first.  */
           if (width[j] != w || tally[j] != t)
-            return -1;
+            {
+              if (!hits)
+                return -1;
+            }
           else
             {
               bool match = true;
@@ -867,15 +1002,19 @@ tables_generate (void)
 
   token_actions ();
 
+  unit_rules_eliminate ();
   goto_actions ();
   free (goto_map);
   free (from_state);
   free (to_state);
 
   order = xcalloc (nvectors, sizeof *order);
+  profile_read ();
   sort_actions ();
   pack_table ();
   free (order);
+  free (hits);
+  hits = NULL;
 
   free (tally);
   free (width);
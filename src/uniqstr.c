@@ -36,23 +36,63 @@
 /* Initial capacity of uniqstr hash table.  */
 #define HT_INITIAL_CAPACITY 257
 
+/* The uniqstrs are stored contiguously in UNIQSTRS_OBSTACK, each one
+   right after its header, which caches its hash and its length.  The
+   hash table contains pointers to these headers.
+
+   Lookups use a header allocated on the stack, whose STR points to
+   the searched string (possibly in the scanner's buffer), so that
+   nothing is copied unless the string is new.  */
+
+typedef struct
+{
+  /* The hash of the LEN first bytes of STR.  */
+  size_t hash;
+  size_t len;
+  /* The NUL-terminated contents.  For the stored uniqstrs, points to
+     the bytes following this header.  */
+  char const *str;
+} uniqstr_header;
+
 static struct hash_table *uniqstrs_table = NULL;
+static struct obstack uniqstrs_obstack;
 
-/*-------------------------------------.
-| Create the uniqstr for S if needed.  |
-`-------------------------------------*/
+static size_t
+uniqstr_hash (char const *str, size_t len)
+{
+  size_t res = 0;
+  for (size_t i = 0; i < len; ++i)
+    res = res * 31 + (unsigned char) str[i];
+  return res;
+}
+
+/*--------------------------------------------------------------.
+| Create the uniqstr for the LEN first bytes of STR if needed.  |
+`--------------------------------------------------------------*/
 
 uniqstr
-uniqstr_new (char const *str)
+uniqstr_new_len (char const *str, size_t len)
 {
-  uniqstr res = hash_lookup (uniqstrs_table, str);
+  uniqstr_header probe = { uniqstr_hash (str, len), len, str };
+  uniqstr_header const *res = hash_lookup (uniqstrs_table, &probe);
   if (!res)
     {
       /* First insertion in the hash. */
-      res = xstrdup (str);
-      hash_xinsert (uniqstrs_table, res);
+      obstack_blank (&uniqstrs_obstack, sizeof probe);
+      obstack_grow0 (&uniqstrs_obstack, str, len);
+      uniqstr_header *h = obstack_finish (&uniqstrs_obstack);
+      *h = probe;
+      h->str = (char const *) (h + 1);
+      hash_xinsert (uniqstrs_table, h);
+      res = h;
     }
-  return res;
+  return res->str;
+}
+
+uniqstr
+uniqstr_new (char const *str)
+{
+  return uniqstr_new_len (str, strlen (str));
 }
 
 uniqstr
@@ -80,9 +120,8 @@ uniqstr_concat (int nargs, ...)
   va_end (args);
 
   *p = '\0';
-  uniqstr res = hash_xinsert (uniqstrs_table, str);
-  if (res != str)
-    free (str);
+  uniqstr res = uniqstr_new_len (str, reslen);
+  free (str);
   return res;
 }
 
@@ -93,8 +132,10 @@ uniqstr_concat (int nargs, ...)
 void
 uniqstr_assert (char const *str)
 {
-  uniqstr s = hash_lookup (uniqstrs_table, str);
-  if (!s || s != str)
+  size_t len = strlen (str);
+  uniqstr_header probe = { uniqstr_hash (str, len), len, str };
+  uniqstr_header const *s = hash_lookup (uniqstrs_table, &probe);
+  if (!s || s->str != str)
     {
       error (0, 0,
              "not a uniqstr: %s", quotearg (str));
@@ -115,9 +156,9 @@ uniqstr_print (uniqstr ustr)
 }
 
 static bool
-uniqstr_print_processor (void *ustr, void *null MAYBE_UNUSED)
+uniqstr_print_processor (void *h, void *null MAYBE_UNUSED)
 {
-  return uniqstr_print (ustr);
+  return uniqstr_print (((uniqstr_header const *) h)->str);
 }
 
 int
@@ -137,13 +178,18 @@ uniqstr_cmp (uniqstr l, uniqstr r)
 static bool
 hash_compare_uniqstr (void const *m1, void const *m2)
 {
-  return STREQ (m1, m2);
+  uniqstr_header const *h1 = m1;
+  uniqstr_header const *h2 = m2;
+  return (h1->hash == h2->hash
+          && h1->len == h2->len
+          && memcmp (h1->str, h2->str, h1->len) == 0);
 }
 
 static size_t
 hash_uniqstr (void const *m, size_t tablesize)
 {
-  return hash_string (m, tablesize);
+  uniqstr_header const *h = m;
+  return h->hash % tablesize;
 }
 
 
@@ -158,7 +204,8 @@ uniqstrs_new (void)
                                      NULL,
                                      hash_uniqstr,
                                      hash_compare_uniqstr,
-                                     free);
+                                     NULL);
+  obstack_init (&uniqstrs_obstack);
 }
 
 
@@ -192,4 +239,5 @@ void
 uniqstrs_free (void)
 {
   hash_free (uniqstrs_table);
+  obstack_free (&uniqstrs_obstack, NULL);
 }
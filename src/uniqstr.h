@@ -32,6 +32,10 @@ typedef char const *uniqstr;
 /* Return the uniqstr for STR.  */
 uniqstr uniqstr_new (char const *str);
 
+/* Return the uniqstr for the LEN first bytes of STR, which need not
+   be NUL-terminated.  */
+uniqstr uniqstr_new_len (char const *str, size_t len);
+
 /* Two uniqstr values have the same value iff they are the same.  */
 # define UNIQSTR_EQ(Ustr1, Ustr2) (!!((Ustr1) == (Ustr2)))
 